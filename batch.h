@@ -0,0 +1,240 @@
+/*
+ * BATCH.H: Tic-Tac-Toe AI headless batch analysis
+ * --------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ */
+#ifndef _TICTACTOE_MINIMAX_BATCH_H_
+#define _TICTACTOE_MINIMAX_BATCH_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "defs.h"
+#include "thread.h"
+#include "board.h"
+#include "engine.h"
+
+/* Analysis of many positions without the game screen: one board a line,
+ * as read by read_board(), the side to move told by the piece counts
+ * (O opens the game, so X is to move when O has one piece more).
+ * Lines are read a chunk at a time, searched by a pool of workers that
+ * each own a context and a small table cleared for every position, and
+ * written in input order, one line each:
+ *   line move score nodes us
+ * 'move' is a cell index, -1 when the game is over, 'score' is for the
+ * side to move ('-' when the move was not scored). Unreadable lines give
+ * "line bad", blank lines and '#' comments give nothing.
+ *   c3 --batch [-d depth] [-t ms] [-j threads] [-e engine] [file]
+ * An engine named by -e searches every position itself, without the book.
+ */
+#define BATCH_CHUNK     4096            /* positions in flight at a time */
+#define BATCH_LINE      256             /* longest input line */
+#define BATCH_TT_MB     1               /* table of each worker */
+#define BATCH_BUFFER    (1 << 16)       /* output buffer */
+
+typedef struct {                        /* one position and its answer */
+    long line;                          /* input line number */
+    game_board board;                   /* position to search */
+    char mover;                         /* side to move there */
+    bool valid;                         /* a board with a side to move */
+    int move;                           /* cell to play, -1 = none */
+    int score;                          /* for the side to move */
+    int nodes;                          /* searched states */
+    int64_t us;                         /* time of the search */
+} batch_item;
+
+typedef struct {                        /* a chunk shared by the workers */
+    batch_item * items;
+    int count;                          /* positions in the chunk */
+    int next;                           /* next one to hand out */
+} batch_queue;
+
+typedef struct {                        /* a worker and its context */
+    batch_queue * queue;
+    engine_ctx ctx;
+} batch_job;
+
+/* =============== PROTOTYPES ==================== */
+
+bool batch_parse(batch_item * item, const char * text);
+
+void batch_analyze(engine_ctx * ctx, batch_item * item);
+
+void * batch_worker(void * arg);
+
+void batch_print(FILE * out, batch_item * item);
+
+bool batch_run(FILE * in, FILE * out, batch_job * jobs, int workers);
+
+bool batch_setup(batch_job * job, int depth, int ms, const search_engine * search, solved_db * db);
+
+int batch_main(int argc, char ** argv, solved_db * db);
+
+/* =============================================== */
+
+/* read a position and its side to move, false if it is no position of a game */
+bool batch_parse(batch_item * item, const char * text) {
+    int xs, os;
+
+    item->valid = false;
+    if (!read_board(&item->board, text)) return false;
+    xs = bit_count(item->board.x);
+    os = bit_count(item->board.o);
+    if (os != xs && os != xs + 1) return false;
+    item->mover = os == xs + 1 ? CELL_X : CELL_O;   /* O opens, as in the game */
+    item->valid = evaluate(&item->board) != piece_score(item->mover);  /* not won yet */
+    return item->valid;
+}
+
+/* the move and score of the side to move, from a cleared table like a new game */
+void batch_analyze(engine_ctx * ctx, batch_item * item) {
+    int64_t start = clock_us();
+
+    if (ctx->states) clear_trans_table(ctx->tt);   /* only a search leaves entries */
+    ctx->states = 0;
+    ctx->board = item->board;
+    ctx->computer = item->mover;
+    ctx->human = item->mover == CELL_X ? CELL_O : CELL_X;
+    ctx->move_count = bit_count(item->board.x | item->board.o);
+    item->move = -1;
+    if (evaluate(&item->board) != SCORE_TIE)
+        item->score = -SCORE_WIN;       /* the side to move has lost */
+    else if (!has_move(&item->board))
+        item->score = SCORE_TIE;        /* a full board */
+    else
+        item->move = select_move(ctx, &item->score);
+    item->nodes = ctx->states;
+    item->us = clock_us() - start;
+}
+
+void * batch_worker(void * arg) {
+    batch_job * job = (batch_job *)arg;
+    batch_queue * q = job->queue;
+    int i;
+
+    while ((i = atomic_add(&q->next, 1)) < q->count)
+        if (q->items[i].valid) batch_analyze(&job->ctx, &q->items[i]);
+    return NULL;
+}
+
+void batch_print(FILE * out, batch_item * item) {
+    if (!item->valid)
+        fprintf(out, "%ld bad\n", item->line);
+    else if (item->score == SCORE_UNKNOWN)
+        fprintf(out, "%ld %d - %d %lld\n", item->line, item->move, item->nodes,
+                (long long)item->us);
+    else
+        fprintf(out, "%ld %d %d %d %lld\n", item->line, item->move, item->score,
+                item->nodes, (long long)item->us);
+}
+
+/* every position of 'in' to 'out', a chunk at a time; false on a read error */
+bool batch_run(FILE * in, FILE * out, batch_job * jobs, int workers) {
+    batch_queue q;
+    thread_t tid[MAX_THREADS];
+    char text[BATCH_LINE];
+    long line = 0;
+    size_t length;
+    int i, started;
+    bool eof = false;
+
+    q.items = (batch_item *)malloc(BATCH_CHUNK * sizeof(batch_item));
+    if (!q.items) return false;
+    while (!eof) {
+        q.count = q.next = 0;
+        while (q.count < BATCH_CHUNK) {
+            if (!fgets(text, sizeof(text), in)) {
+                eof = true;
+                break;
+            }
+            line++;
+            length = strlen(text);
+            if (length == sizeof(text) - 1 && text[length - 1] != '\n') {
+                int c;                  /* too long for a board: skip the rest */
+                while ((c = fgetc(in)) != EOF && c != '\n');
+                text[0] = '?';
+            }
+            if (text[0] == '#' || text[0] == '\n' || text[0] == '\r' || text[0] == 0) continue;
+            q.items[q.count].line = line;
+            batch_parse(&q.items[q.count++], text);
+        }
+        for (started = 1; started < workers; started++) {
+            jobs[started].queue = &q;
+            if (!thread_start(&tid[started], batch_worker, &jobs[started])) break;
+        }
+        jobs[0].queue = &q;
+        batch_worker(&jobs[0]);         /* this thread is worker 0 */
+        for (i = 1; i < started; i++) thread_join(tid[i]);
+        for (i = 0; i < q.count; i++) batch_print(out, &q.items[i]);
+    }
+    free(q.items);
+    fflush(out);
+    return !ferror(in);
+}
+
+/* a worker's context: the default PVS with the book and database, or the
+ * named 'search' alone so that it is the engine being analysed
+ */
+bool batch_setup(batch_job * job, int depth, int ms, const search_engine * search, solved_db * db) {
+    if (!engine_init(&job->ctx, BATCH_TT_MB)) return false;
+    job->ctx.game_depth = depth;
+    job->ctx.time_budget = ms;
+    job->ctx.db = db;
+    if (search) {
+        engine_use(&job->ctx, search);
+        job->ctx.book = false;          /* no book_probe() or db_probe() answers */
+    }
+    return true;
+}
+
+/* c3 --batch [-d depth] [-t ms] [-j threads] [-e engine] [file], returns the exit code */
+int batch_main(int argc, char ** argv, solved_db * db) {
+    int depth = GAME_IMPOSSIBLE, ms = 0, workers = cpu_count(), i;
+    const char * path = NULL, * name = NULL;
+    const search_engine * search = NULL;
+    batch_job * jobs;
+    FILE * in = stdin;
+    bool ok;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-d") && i + 1 < argc)      depth = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) ms = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-j") && i + 1 < argc) workers = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-e") && i + 1 < argc) name = argv[++i];
+        else if (argv[i][0] != '-' || !argv[i][1])       path = argv[i];
+        else depth = 0;                 /* unknown option */
+    }
+    if (name) search = engine_find(name);
+    if (depth <= GAME_EASY || depth > CELL_COUNT || ms < 0 || workers < 1 || (name && !search)) {
+        fprintf(stderr, "c3 --batch [-d depth] [-t ms] [-j threads] [-e engine] [file]\n"
+                        "  depth: %d to %d plies, default %d\n", GAME_EASY + 1, CELL_COUNT,
+                        GAME_IMPOSSIBLE);
+        for (i = 0; i < engine_count(); i++)
+            fprintf(stderr, "  %-8s %s\n", engine_at(i)->name, engine_at(i)->info);
+        return 2;
+    }
+    if (workers > MAX_THREADS) workers = MAX_THREADS;
+    if (path && strcmp(path, "-") && !(in = fopen(path, "r"))) {
+        fprintf(stderr, "cannot read %s\n", path);
+        return 2;
+    }
+
+    jobs = (batch_job *)calloc(workers, sizeof(batch_job));
+    for (i = 0; jobs && i < workers; i++)
+        if (!batch_setup(&jobs[i], depth, ms, search, db)) break;
+    if (!jobs || i < workers) {
+        fprintf(stderr, "out of memory\n");
+        ok = false;
+    } else {
+        setvbuf(stdout, NULL, _IOFBF, BATCH_BUFFER);   /* no line by line writes */
+        printf("# line move score nodes us\n");
+        ok = batch_run(in, stdout, jobs, workers);
+    }
+    for (int j = 0; jobs && j < i; j++) engine_free(&jobs[j].ctx);
+    free(jobs);
+    if (in != stdin) fclose(in);
+    return ok ? 0 : 1;
+}
+
+#endif
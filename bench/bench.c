@@ -0,0 +1,174 @@
+/*
+ * BENCH.C: Tic-Tac-Toe AI search benchmark
+ * --------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ *
+ * Plays computer_move() on every position of the corpus for the board
+ * size it is built for, at each fixed depth level, several times over
+ * with a cleared table. Prints one line per position and level:
+ *   size k position level nodes tt_hit% move median_us p95_us knodes/s
+ * The same lines make a baseline file. Against a baseline it fails when
+ * a node count, or the summed median time, grows by more than the
+ * threshold. Boards searched in less than BENCH_FLOOR in all only have
+ * their node counts judged:
+ *   bench [-r runs] [-t percent] [-b baseline] [-e engine] corpus
+ * The engine is PVS unless another registered one is named.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../defs.h"
+#include "../engine.h"
+
+#define BENCH_RUNS      5               /* runs of each position and level */
+#define BENCH_SLOWER    25              /* percent worse than the baseline that fails */
+#define BENCH_FLOOR     20000           /* us: shorter totals are too noisy to judge */
+#define BENCH_LINE      256
+
+typedef struct {                        /* one position at one level */
+    char name[32];
+    char level[16];
+    long nodes;
+    double hits;                        /* table hit rate in percent */
+    int move;
+    int64_t median, p95;                /* microseconds */
+} bench_result;
+
+static const struct { const char * name; int depth; } levels[] = {
+    { "medium", GAME_MEDIUM }, { "hard", GAME_HARD }, { "impossible", GAME_IMPOSSIBLE }
+};
+
+static int by_time(const void * a, const void * b) {
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+/* time 'runs' moves of the engine from 'g' at 'depth' */
+static void bench_run(bench_result * r, game_board * g, int depth, int runs) {
+    int64_t times[64], start;
+    long probes = 0, hits = 0;
+
+    if (runs > 64) runs = 64;
+    for (int i = 0; i < runs; i++) {
+        new_game(&engine);              /* cleared table and no history */
+        memset(engine.history, 0, sizeof(engine.history));
+        engine.board = *g;
+        engine.move_count = bit_count(g->x | g->o);
+        engine.game_depth = depth;
+        start = clock_us();
+        computer_move(&engine);
+        times[i] = clock_us() - start;
+        r->nodes = engine.states;
+        probes = engine.tt_probes;
+        hits = engine.tt_hits;
+        r->move = engine.board.x != g->x ? bit_scan(engine.board.x & ~g->x) : -1;
+    }
+    qsort(times, runs, sizeof(int64_t), by_time);
+    r->median = times[runs / 2];
+    r->p95 = times[(runs * 95 + 99) / 100 - 1];
+    r->hits = probes ? 100.0 * hits / probes : 0.0;
+}
+
+static void bench_print(FILE * f, bench_result * r) {
+    fprintf(f, "%d %d %-12s %-10s %10ld %6.1f %3d %10lld %10lld %10lld\n",
+            BOARD_SIZE, WIN_LENGTH, r->name, r->level, r->nodes, r->hits, r->move,
+            (long long)r->median, (long long)r->p95,
+            (long long)(r->nodes * 1000 / (r->median > 0 ? r->median : 1)));
+}
+
+/* compare against the baseline lines of this board, false on a regression */
+static bool bench_compare(const char * path, bench_result * results, int count, int slower) {
+    char line[BENCH_LINE], name[32], level[16];
+    int size, k, move, matched = 0;
+    long nodes;
+    double hits;
+    long long median, p95, rate;
+    int64_t base_total = 0, total = 0;
+    bool ok = true;
+    FILE * f = fopen(path, "r");
+
+    if (!f) {
+        fprintf(stderr, "no baseline %s, nothing compared\n", path);
+        return true;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "%d %d %31s %15s %ld %lf %d %lld %lld %lld", &size, &k, name, level,
+                   &nodes, &hits, &move, &median, &p95, &rate) != 10) continue;
+        if (size != BOARD_SIZE || k != WIN_LENGTH) continue;
+        for (int i = 0; i < count; i++) {
+            bench_result * r = &results[i];
+            if (strcmp(r->name, name) || strcmp(r->level, level)) continue;
+            matched++;
+            base_total += median;
+            total += r->median;
+            if (r->nodes * 100 > nodes * (100 + slower)) {
+                printf("REGRESSION %s %s: %ld nodes, baseline %ld\n", name, level, r->nodes, nodes);
+                ok = false;
+            }
+            if (r->move != move)
+                printf("note %s %s: plays %d, baseline %d\n", name, level, r->move, move);
+        }
+    }
+    fclose(f);
+
+    printf("%d of %d results in the baseline, median time %lld us, baseline %lld us (%+.1f%%)\n",
+           matched, count, (long long)total, (long long)base_total,
+           base_total ? 100.0 * (total - base_total) / base_total : 0.0);
+    if (base_total >= BENCH_FLOOR && total * 100 > base_total * (100 + slower)) {
+        printf("REGRESSION: more than %d%% slower than the baseline\n", slower);
+        ok = false;
+    }
+    return ok;
+}
+
+int main(int argc, char ** argv) {
+    const char * corpus = NULL, * baseline = NULL, * algo = "PVS";
+    int runs = BENCH_RUNS, slower = BENCH_SLOWER, count = 0, size, k;
+    char line[BENCH_LINE], name[32], cells[BENCH_LINE];
+    bench_result results[256];
+    game_board g;
+    FILE * f;
+    bool ok = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-r") && i + 1 < argc)      runs = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) slower = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc) baseline = argv[++i];
+        else if (!strcmp(argv[i], "-e") && i + 1 < argc) algo = argv[++i];
+        else corpus = argv[i];
+    }
+    if (!corpus || runs < 1 || !engine_find(algo)) {
+        fprintf(stderr, "bench [-r runs] [-t percent] [-b baseline] [-e engine] corpus\n");
+        return 2;
+    }
+    if (!(f = fopen(corpus, "r"))) {
+        fprintf(stderr, "cannot read %s\n", corpus);
+        return 2;
+    }
+    engine_init(&engine, TT_DEFAULT_MB);
+    engine_use(&engine, engine_find(algo));
+    engine.book = false;                /* search every position */
+
+    printf("# size k position level nodes tt_hit%% move median_us p95_us knodes/s\n");
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "%d %d %31s %s", &size, &k, name, cells) != 4 || line[0] == '#') continue;
+        if (size != BOARD_SIZE || k != WIN_LENGTH) continue;
+        if (!read_board(&g, cells)) {
+            fprintf(stderr, "bad position %s\n", name);
+            continue;
+        }
+        for (int l = 0; l < (int)(sizeof(levels) / sizeof(levels[0])) && count < 256; l++) {
+            bench_result * r = &results[count++];
+            strcpy(r->name, name);
+            strcpy(r->level, levels[l].name);
+            bench_run(r, &g, levels[l].depth, runs);
+            bench_print(stdout, r);
+            fflush(stdout);
+        }
+    }
+    fclose(f);
+    if (baseline) ok = bench_compare(baseline, results, count, slower);
+    engine_free(&engine);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,382 @@
+/*
+ * BOARD.H: Tic-Tac-Toe AI bitboard primitives
+ * --------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ */
+#ifndef _TICTACTOE_MINIMAX_BOARD_H_
+#define _TICTACTOE_MINIMAX_BOARD_H_
+
+#include <string.h>
+#include "defs.h"
+
+#define FULL_MASK   ((bitmask)((((uint64_t)1 << (CELL_COUNT - 1)) << 1) - 1))
+#define CELL_LINES   (4 * WIN_LENGTH)   /* most lines through one cell */
+
+/* =============== PROTOTYPES ==================== */
+
+void init_masks();
+
+void init_zobrist();
+
+uint64_t zobrist_key(game_board * g);
+
+int unique_moves(game_board * g, int * moves, int n);
+
+uint64_t board_code(game_board * g, int sym);
+
+bitmask cell_mask(int c, int r);
+
+char get_cell(game_board * g, int c, int r);
+
+void set_cell(game_board * g, int c, int r, char piece);
+
+int evaluate_move(game_board * g, int c, int r);
+
+bool read_board(game_board * g, const char * cells);
+
+int gen_moves(game_board * g, int * moves);
+
+void move_to_front(int * moves, int n, int sq);
+
+/* =============================================== */
+
+bitmask line_masks[LINE_COUNT];         /* winning lines */
+uint8_t move_order[CELL_COUNT];         /* static move ordering */
+uint8_t order_class[CELL_COUNT];        /* group of alike cells in that order */
+uint8_t cell_lines[CELL_COUNT][CELL_LINES]; /* lines through each cell */
+uint8_t cell_line_count[CELL_COUNT];
+bool masks_ready = false;
+uint64_t zobrist[2][CELL_COUNT];        /* piece keys, [0] = X, [1] = O */
+uint64_t zobrist_side;                  /* computer to move */
+uint8_t sym_cell[SYMMETRIES][CELL_COUNT];   /* where each symmetry sends a cell */
+uint8_t sym_back[SYMMETRIES][CELL_COUNT];   /* and where it came from */
+uint64_t pow3[CELL_COUNT];              /* base-3 digit weights of the cells */
+int line_score[WIN_LENGTH+1][WIN_LENGTH+1]; /* heuristic of a line by X's and O's */
+bitmask edge_masks[2];                  /* cells off the first, off the last column */
+
+/* index of the lowest set bit, mask must not be zero */
+static inline int bit_scan(bitmask m) {
+#if defined(__GNUC__)
+    return __builtin_ctzll((unsigned long long)m);
+#else
+    int i = 0;
+    while (!(m & 1)) { m >>= 1; i++; }
+    return i;
+#endif
+}
+
+/* number of set bits */
+static inline int bit_count(bitmask m) {
+#if defined(__GNUC__)
+    return __builtin_popcountll((unsigned long long)m);
+#else
+    int n = 0;
+    for (; m; m &= m - 1) n++;
+    return n;
+#endif
+}
+
+/* put a piece on an empty cell */
+static inline void place(game_board * g, int sq, char piece) {
+    int side = piece != CELL_X, l;
+    if (piece == CELL_X) g->x |= (bitmask)1 << sq;
+    else                 g->o |= (bitmask)1 << sq;
+    for (int t = 0; t < SYMMETRIES; t++)
+        g->keys[t] ^= zobrist[side][sym_cell[t][sq]];
+    for (int i = 0; i < cell_line_count[sq]; i++) {
+        l = cell_lines[sq][i];          /* rescore only the lines it is on */
+        g->heuristic -= line_score[g->count[0][l]][g->count[1][l]];
+        g->count[side][l]++;
+        g->heuristic += line_score[g->count[0][l]][g->count[1][l]];
+    }
+}
+
+/* take a piece back from its cell */
+static inline void unplace(game_board * g, int sq, char piece) {
+    int side = piece != CELL_X, l;
+    if (piece == CELL_X) g->x &= (bitmask)~((bitmask)1 << sq);
+    else                 g->o &= (bitmask)~((bitmask)1 << sq);
+    for (int t = 0; t < SYMMETRIES; t++)
+        g->keys[t] ^= zobrist[side][sym_cell[t][sq]];
+    for (int i = 0; i < cell_line_count[sq]; i++) {
+        l = cell_lines[sq][i];
+        g->heuristic -= line_score[g->count[0][l]][g->count[1][l]];
+        g->count[side][l]--;
+        g->heuristic += line_score[g->count[0][l]][g->count[1][l]];
+    }
+}
+
+/* evaluation score of a win by 'piece' */
+static inline int piece_score(char piece) {
+    return piece == CELL_X ? SCORE_X : SCORE_O;
+}
+
+/* score of a win by 'piece' on move 'ply' of the search, sooner is better */
+static inline int win_score(char piece, int ply) {
+    return piece == CELL_X ? SCORE_X - ply : SCORE_O + ply;
+}
+
+/* a win after 'ply' plies for the side the score is for, negated a loss */
+static inline int mate_score(int ply) {
+    return SCORE_WIN - ply;
+}
+
+/* a score of X, such as the heuristic, as 'piece' sees it */
+static inline int score_for(char piece, int score) {
+    return piece == CELL_X ? score : -score;
+}
+
+/* is the score a won or lost game rather than a guess? */
+static inline bool score_decided(int score) {
+    return score >= SCORE_MATE || score <= -SCORE_MATE;
+}
+
+/* did the piece just placed on 'sq' complete one of its lines? */
+static inline bool wins_at(game_board * g, int sq, char piece) {
+    int side = piece != CELL_X;
+    for (int i = 0; i < cell_line_count[sq]; i++)
+        if (g->count[side][cell_lines[sq][i]] == WIN_LENGTH) return true;
+    return false;
+}
+
+/* the smallest key over all symmetries, alike positions share it;
+ * 'sym' gets the symmetry that leads to it
+ */
+static inline uint64_t canonical_key(game_board * g, int * sym) {
+    uint64_t key = g->keys[0];
+    *sym = 0;
+    for (int t = 1; t < SYMMETRIES; t++)
+        if (g->keys[t] < key) {
+            key = g->keys[t];
+            *sym = t;
+        }
+    return key;
+}
+
+/* cells next to any cell of 'm', diagonals included */
+static inline bitmask grow(bitmask m) {
+    bitmask h = m | ((m >> 1) & edge_masks[1]) | ((m << 1) & edge_masks[0]);
+    return (bitmask)((h | (h >> BOARD_SIZE) | (h << BOARD_SIZE)) & FULL_MASK);
+}
+
+/* mask of all empty cells */
+static inline bitmask empty_cells(game_board * g) {
+    return (bitmask)(FULL_MASK & ~(g->x | g->o));
+}
+
+/* squared distance of a cell from the center, in half cells */
+static inline int center_distance(int sq) {
+    int dc = 2 * (sq % BOARD_SIZE) - (BOARD_SIZE - 1);
+    int dr = 2 * (sq / BOARD_SIZE) - (BOARD_SIZE - 1);
+    return dc * dc + dr * dr;
+}
+
+/* does cell 'a' come before cell 'b' in the static move order? */
+static inline bool order_before(int a, int b) {
+    if (cell_line_count[a] != cell_line_count[b])
+        return cell_line_count[a] > cell_line_count[b];    /* more lines */
+    if (center_distance(a) != center_distance(b))
+        return center_distance(a) < center_distance(b);    /* then central */
+    return a < b;
+}
+
+/* precompute the line masks, static move order, symmetries and Zobrist keys */
+void init_masks() {
+    static const int steps[4][2] = { {1, 0}, {0, 1}, {1, 1}, {-1, 1} };
+    int i, j, r, c, t, x, y, lines;
+
+    if (masks_ready) return;
+
+    /* every run of WIN_LENGTH cells: rows, columns, then both diagonals,
+     * which are the whole lines themselves when WIN_LENGTH is BOARD_SIZE
+     */
+    lines = 0;
+    for (t = 0; t < 4; t++)
+    for (r = 0; r < BOARD_SIZE; r++)
+    for (c = 0; c < BOARD_SIZE; c++) {
+        x = c + steps[t][0] * (WIN_LENGTH - 1);
+        y = r + steps[t][1] * (WIN_LENGTH - 1);
+        if (x < 0 || x >= BOARD_SIZE || y >= BOARD_SIZE) continue;
+        line_masks[lines] = 0;
+        for (i = 0; i < WIN_LENGTH; i++)
+            line_masks[lines] |= cell_mask(c + steps[t][0] * i, r + steps[t][1] * i);
+        lines++;
+    }
+
+    edge_masks[0] = edge_masks[1] = FULL_MASK;
+    for (r = 0; r < BOARD_SIZE; r++) {
+        edge_masks[0] &= ~cell_mask(0, r);
+        edge_masks[1] &= ~cell_mask(BOARD_SIZE - 1, r);
+    }
+
+    for (i = 0; i < CELL_COUNT; i++) {
+        lines = 0;
+        for (r = 0; r < LINE_COUNT; r++)
+            if (line_masks[r] & ((bitmask)1 << i)) cell_lines[i][lines++] = r;
+        cell_line_count[i] = lines;
+    }
+
+    /* cells on more lines come first, then the ones nearer the center:
+     * on 3x3 that is the center, the corners, then the edges
+     */
+    for (i = 0; i < CELL_COUNT; i++) {
+        for (j = i; j > 0 && order_before(i, move_order[j-1]); j--)
+            move_order[j] = move_order[j-1];
+        move_order[j] = i;
+    }
+    for (i = 0, c = 0; i < CELL_COUNT; i++) {   /* same lines and distance */
+        if (i > 0 && (cell_line_count[move_order[i]] != cell_line_count[move_order[i-1]]
+                   || center_distance(move_order[i]) != center_distance(move_order[i-1])))
+            c++;
+        order_class[move_order[i]] = c;
+    }
+
+    /* symmetry t mirrors the board if t >= 4, then turns it t % 4 times */
+    for (t = 0; t < SYMMETRIES; t++)
+    for (i = 0; i < CELL_COUNT; i++) {
+        x = i % BOARD_SIZE;
+        y = i / BOARD_SIZE;
+        if (t & 4) x = BOARD_SIZE - 1 - x;
+        for (j = 0; j < (t & 3); j++) {
+            r = x;
+            x = BOARD_SIZE - 1 - y;
+            y = r;
+        }
+        sym_cell[t][i] = y * BOARD_SIZE + x;
+        sym_back[t][y * BOARD_SIZE + x] = i;
+    }
+    for (i = 0; i < CELL_COUNT; i++)   /* exact up to 40 cells */
+        pow3[i] = i ? pow3[i-1] * 3 : 1;
+
+    /* a line still open to one side is worth 4 times more per piece on it,
+     * a line holding both pieces is dead
+     */
+    for (x = 0; x <= WIN_LENGTH; x++)
+    for (y = 0; y <= WIN_LENGTH; y++)
+        line_score[x][y] = x && !y ? 1 << (2 * (x - 1))
+                         : y && !x ? -(1 << (2 * (y - 1))) : 0;
+    init_zobrist();
+    masks_ready = true;
+}
+
+/* fill the Zobrist keys from a fixed seed (splitmix64) */
+void init_zobrist() {
+    uint64_t seed = 0x3C3C3C3C3C3C3C3CULL, z;
+
+    for (int i = 0; i < 2 * CELL_COUNT + 1; i++) {
+        z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        if (i < 2 * CELL_COUNT) zobrist[i & 1][i >> 1] = z;
+        else                    zobrist_side = z;
+    }
+}
+
+/* recompute the key of a board as it is from scratch */
+uint64_t zobrist_key(game_board * g) {
+    uint64_t key = 0;
+    bitmask m;
+    for (m = g->x; m; m &= m - 1) key ^= zobrist[0][bit_scan(m)];
+    for (m = g->o; m; m &= m - 1) key ^= zobrist[1][bit_scan(m)];
+    return key;
+}
+
+/* drop moves that a symmetry of the position maps onto an earlier move */
+int unique_moves(game_board * g, int * moves, int n) {
+    bitmask seen = 0;
+    int i, t, k = 0;
+
+    for (i = 0; i < n; i++) {
+        if (seen & ((bitmask)1 << moves[i])) continue;  /* a twin was kept */
+        for (t = 0; t < SYMMETRIES; t++)
+            if (g->keys[t] == g->keys[0])   /* the position looks the same */
+                seen |= (bitmask)1 << sym_cell[t][moves[i]];
+        moves[k++] = moves[i];
+    }
+    return k;
+}
+
+/* base-3 index of the board seen through a symmetry,
+ * a cell is worth 0 when empty, 1 for X and 2 for O
+ */
+uint64_t board_code(game_board * g, int sym) {
+    uint64_t code = 0;
+    bitmask m;
+    for (m = g->x; m; m &= m - 1) code += pow3[sym_cell[sym][bit_scan(m)]];
+    for (m = g->o; m; m &= m - 1) code += 2 * pow3[sym_cell[sym][bit_scan(m)]];
+    return code;
+}
+
+/* single bit mask of a cell */
+bitmask cell_mask(int c, int r) {
+    return (bitmask)1 << (r * BOARD_SIZE + c);
+}
+
+/* piece on a cell: CELL_X, CELL_O or CELL_E */
+char get_cell(game_board * g, int c, int r) {
+    bitmask m = cell_mask(c, r);
+    if (g->x & m) return CELL_X;
+    if (g->o & m) return CELL_O;
+    return CELL_E;
+}
+
+/* overwrite a cell, mainly used to set up positions */
+void set_cell(game_board * g, int c, int r, char piece) {
+    int sq = r * BOARD_SIZE + c;
+    char old = get_cell(g, c, r);
+    if (old != CELL_E) unplace(g, sq, old);
+    if (piece != CELL_E) place(g, sq, piece);
+}
+
+/* score of the move just played on (c, r): only its own lines can win */
+int evaluate_move(game_board * g, int c, int r) {
+    char piece = get_cell(g, c, r);
+    if (piece == CELL_E || !wins_at(g, r * BOARD_SIZE + c, piece)) return SCORE_TIE;
+    return piece_score(piece);
+}
+
+/* a board from its cells row by row, "X.O/.X./..O": 'X', 'O' or '.' each,
+ * '/' between rows optional, up to the first blank; false if it does not fit
+ */
+bool read_board(game_board * g, const char * cells) {
+    int sq = 0;
+
+    init_masks();
+    memset(g, 0, sizeof(game_board));
+    for (; *cells && *cells != ' ' && *cells != '\t' && *cells != '\n' && *cells != '\r'; cells++) {
+        if (*cells == '/') continue;
+        if (sq >= CELL_COUNT) return false;
+        if (*cells == 'X' || *cells == 'O') place(g, sq, *cells == 'X' ? CELL_X : CELL_O);
+        else if (*cells != '.') return false;
+        sq++;
+    }
+    return sq == CELL_COUNT;
+}
+
+/* list the empty cells in static move order, returns the move count.
+ * Under k-in-a-row rules only the cells next to a piece are worth trying.
+ */
+int gen_moves(game_board * g, int * moves) {
+    bitmask empty = empty_cells(g);
+    int n = 0;
+#if K_IN_A_ROW
+    if ((g->x | g->o) && (empty & grow(g->x | g->o)))   /* else anywhere */
+        empty &= grow(g->x | g->o);
+#endif
+    for (int i = 0; i < CELL_COUNT; i++)
+        if (empty & ((bitmask)1 << move_order[i])) moves[n++] = move_order[i];
+    return n;
+}
+
+/* try a hinted move first, keeping the order of the others */
+void move_to_front(int * moves, int n, int sq) {
+    int i = 0;
+    while (i < n && moves[i] != sq) i++;
+    if (i == n) return;                 /* no such move here */
+    for (; i > 0; i--) moves[i] = moves[i-1];
+    moves[0] = sq;
+}
+
+#endif
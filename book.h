@@ -0,0 +1,85 @@
+/*
+ * BOOK.H: Tic-Tac-Toe AI perfect play table
+ * -------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ */
+#ifndef _TICTACTOE_MINIMAX_BOOK_H_
+#define _TICTACTOE_MINIMAX_BOOK_H_
+
+#include "defs.h"
+#include "board.h"
+
+/* The 3x3 game is solved once by tools/gen3.c into book3.h. Every
+ * position is stored once, under the smallest base-3 code among its
+ * symmetries, with the side to move, its value and the best move as
+ * seen on that canonical board.
+ *
+ * entry layout: code:23 | side:1 | value:4 | move:4, sorted by code and side
+ */
+#define BOOK_ENTRY(code, side, value, move) \
+            (((uint32_t)(code) << 9) | ((uint32_t)(side) << 8) | ((value) << 4) | (move))
+#define BOOK_KEY(e)     ((e) >> 8)
+#define BOOK_VALUE(e)   ((int)(((e) >> 4) & 15))
+#define BOOK_MOVE(e)    ((int)((e) & 15))
+
+typedef enum {                      /* value for the side to move */
+    BOOK_LOSS, BOOK_DRAW, BOOK_WIN
+} book_value;
+
+#if BOARD_SIZE == 3 && !defined(_BOOK_GENERATOR_)
+    #include "book3.h"
+    #define _USE_BOOK_
+#endif
+
+/* =============== PROTOTYPES ==================== */
+
+uint64_t book_key(game_board * g, char piece, int * sym);
+
+int book_probe(game_board * g, char piece, int * score);
+
+/* =============================================== */
+
+/* table key of a position with 'piece' to move, 'sym' gets the symmetry
+ * that turns the board into its canonical form
+ */
+uint64_t book_key(game_board * g, char piece, int * sym) {
+    uint64_t code, best = board_code(g, 0);
+    *sym = 0;
+    for (int t = 1; t < SYMMETRIES; t++)
+        if ((code = board_code(g, t)) < best) {
+            best = code;
+            *sym = t;
+        }
+    return best * 2 + (piece != CELL_X);
+}
+
+/* perfect move for 'piece', -1 if the position is not in the table;
+ * 'score' gets the value of the game the way the search scores it
+ */
+int book_probe(game_board * g, char piece, int * score) {
+#ifdef _USE_BOOK_
+    int sym, lo = 0, hi = BOOK3_SIZE - 1, mid;
+    uint64_t key = book_key(g, piece, &sym), k;
+
+    while (lo <= hi) {                  /* binary search, entries are sorted */
+        mid = (lo + hi) / 2;
+        k = BOOK_KEY(book3[mid]);
+        if (k == key) {
+            switch (BOOK_VALUE(book3[mid])) {
+            case BOOK_WIN:  *score = piece_score(piece); break;
+            case BOOK_LOSS: *score = -piece_score(piece); break;
+            default:        *score = SCORE_TIE;
+            }
+            return sym_back[sym][BOOK_MOVE(book3[mid])];
+        }
+        if (k < key) lo = mid + 1;
+        else         hi = mid - 1;
+    }
+#else
+    (void)g; (void)piece; (void)score;
+#endif
+    return -1;
+}
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ * BOOK3.H: Tic-Tac-Toe AI perfect play table for 3x3
+ * --------
+ * Generated by tools/gen3.c, do not edit: run "make book" instead
+ */
+#ifndef _TICTACTOE_MINIMAX_BOOK3_H_
+#define _TICTACTOE_MINIMAX_BOOK3_H_
+
+#define BOOK3_SIZE 1254
+
+const uint32_t book3[BOOK3_SIZE] = {
+    0x0000014, 0x0000114, 0x0000314, 0x0000414, 0x0000714, 0x0000A14, 0x0000B24, 0x0000C14,
+    0x0000E24, 0x0000F14, 0x0001626, 0x0001726, 0x0001D26, 0x0002114, 0x0002228, 0x0002E14,
+    0x0004114, 0x0004224, 0x0004324, 0x0004506, 0x0004602, 0x0004D14, 0x0005514, 0x0005824,
+    0x0005924, 0x0005A20, 0x0005B24, 0x0005D06, 0x0005E01, 0x0006128, 0x0006424, 0x0006524,
+    0x0006620, 0x0006826, 0x0006906, 0x0007A14, 0x0007E24, 0x0007F20, 0x0008101, 0x0008206,
+    0x0008520, 0x0008806, 0x0008926, 0x0008A28, 0x0008C24, 0x0008D24, 0x0009214, 0x0009614,
+    0x0009824, 0x0009924, 0x000A310, 0x000A612, 0x000A712, 0x000AD17, 0x000AE20, 0x000AF10,
+    0x000B108, 0x000B212, 0x000B916, 0x000C426, 0x000C516, 0x000CA11, 0x000D027, 0x000D117,
+    0x000E505, 0x000E825, 0x000E922, 0x000FB06, 0x000FD15, 0x0010025, 0x0010121, 0x0010706,
+    0x0010825, 0x0010920, 0x0010B06, 0x0011A10, 0x0011C28, 0x0011D18, 0x0012106, 0x0012426,
+    0x0012526, 0x0012B26, 0x0012C26, 0x0012D16, 0x0012F06, 0x0013026, 0x0013210, 0x0013428,
+    0x0013518, 0x0013827, 0x0013917, 0x0013B06, 0x0013C27, 0x0014028, 0x0014410, 0x0014612,
+    0x0014712, 0x0014A10, 0x0014B20, 0x0014D12, 0x0014E08, 0x0015217, 0x0015911, 0x0015A18,
+    0x0016018, 0x0016128, 0x0016417, 0x0016527, 0x0018110, 0x0018418, 0x0018528, 0x0018607,
+    0x0018826, 0x0018927, 0x0018D10, 0x0019018, 0x0019128, 0x0019728, 0x0019817, 0x0019927,
+    0x0019B27, 0x0019C06, 0x0019E06, 0x001A026, 0x001A126, 0x001A416, 0x001A526, 0x001A726,
+    0x001A806, 0x001AC26, 0x001C215, 0x001C421, 0x001C525, 0x001C820, 0x001C925, 0x001CC06,
+    0x001D006, 0x001DC06, 0x0022124, 0x0022924, 0x0022C24, 0x0022D22, 0x0023F04, 0x0024424,
+    0x0024521, 0x0024B24, 0x0025214, 0x0025314, 0x0025512, 0x0025616, 0x0025912, 0x0025C26,
+    0x0025D26, 0x0025E10, 0x0026028, 0x0026114, 0x0026518, 0x0026828, 0x0026926, 0x0026F26,
+    0x0027028, 0x0027128, 0x0027318, 0x0027428, 0x0027610, 0x0027814, 0x0027914, 0x0027C14,
+    0x0027D26, 0x0027F14, 0x0028016, 0x0028414, 0x002F510, 0x002F816, 0x002F926, 0x002FF26,
+    0x0030022, 0x0030120, 0x0030318, 0x0030402, 0x0030B26, 0x0031300, 0x0031626, 0x0031726,
+    0x0031810, 0x0031920, 0x0031B18, 0x0031C06, 0x0031F17, 0x0032227, 0x0032326, 0x0032410,
+    0x0032628, 0x0032718, 0x0036120, 0x0036408, 0x0036528, 0x0036B28, 0x0036C07, 0x0036D27,
+    0x0036F27, 0x0037002, 0x0037728, 0x0038228, 0x0038328, 0x0038806, 0x0038E06, 0x0038F26,
+    0x0039610, 0x0039822, 0x0039912, 0x0039C22, 0x0039D20, 0x0039F12, 0x003A002, 0x003A417,
+    0x003A828, 0x003A918, 0x003AB06, 0x003AC28, 0x003AF00, 0x003B228, 0x003B326, 0x003B428,
+    0x003B628, 0x003B727, 0x003BC16, 0x003C016, 0x003C216, 0x003C326, 0x0043A24, 0x0043E24,
+    0x0044022, 0x0044124, 0x0044C21, 0x0044D24, 0x0045404, 0x0045824, 0x004DA20, 0x004DC28,
+    0x004DD08, 0x004E027, 0x004E107, 0x004E302, 0x004E427, 0x004E828, 0x004EF06, 0x004F026,
+    0x004F626, 0x004F726, 0x004FA26, 0x004FB06, 0x005C904, 0x005D114, 0x005D424, 0x005D524,
+    0x005D620, 0x005D720, 0x005D903, 0x005DA01, 0x005DD14, 0x005E027, 0x005E128, 0x005E220,
+    0x005E423, 0x005E503, 0x0060B24, 0x0060D20, 0x0061001, 0x0061121, 0x0061728, 0x0061820,
+    0x0061920, 0x0063C24, 0x0063D24, 0x0063F24, 0x0064024, 0x0064214, 0x0064428, 0x0064525,
+    0x0064827, 0x0064925, 0x0064B25, 0x0064C27, 0x0065028, 0x0067910, 0x0067C11, 0x0067D21,
+    0x0068317, 0x0068420, 0x0068520, 0x0068708, 0x006B321, 0x006BB20, 0x006E428, 0x006E510,
+    0x006E718, 0x006E811, 0x006EB17, 0x006EE27, 0x006EF17, 0x006F010, 0x006F228, 0x006F318,
+    0x0070911, 0x0070C28, 0x0070D28, 0x0071328, 0x0071417, 0x0071527, 0x0071727, 0x0071808,
+    0x0071A10, 0x0071C23, 0x0071D13, 0x0072010, 0x0072128, 0x0072313, 0x0072418, 0x0072823,
+    0x0074B27, 0x0074E08, 0x0074F28, 0x0075020, 0x0075120, 0x0075408, 0x0075710, 0x0075A18,
+    0x0075B28, 0x0075C20, 0x0078000, 0x0078208, 0x0078325, 0x0078815, 0x0078C15, 0x0078E15,
+    0x0078F25, 0x0079D12, 0x007A514, 0x007A822, 0x007A922, 0x007BB04, 0x007C011, 0x007C121,
+    0x007C714, 0x007C820, 0x007C920, 0x007CB03, 0x007DF22, 0x007F721, 0x007FF20, 0x0080822,
+    0x0080912, 0x0080F04, 0x0081022, 0x0081114, 0x0081314, 0x0081422, 0x0081B04, 0x0082304,
+    0x0082624, 0x0082704, 0x0082814, 0x0082914, 0x0082B14, 0x0082C11, 0x0082F14, 0x0083227,
+    0x0083314, 0x0083410, 0x0083628, 0x0083714, 0x0084B22, 0x0086321, 0x0086B20, 0x008AB12,
+    0x008B312, 0x008B622, 0x008B722, 0x008CB10, 0x008CE11, 0x008CF21, 0x008D517, 0x008D610,
+    0x008D720, 0x008D918, 0x008E028, 0x008E128, 0x008E728, 0x008E817, 0x008E927, 0x008EB27,
+    0x008EC02, 0x008F328, 0x008FB27, 0x008FE28, 0x008FF28, 0x0090313, 0x0090408, 0x0090710,
+    0x0090A18, 0x0090B28, 0x0090C00, 0x0090E23, 0x0090F27, 0x0091728, 0x0091F27, 0x0092202,
+    0x0092322, 0x0093528, 0x0093720, 0x0093A08, 0x0093B28, 0x0094128, 0x0094220, 0x0094320,
+    0x0094B12, 0x0094C28, 0x0094F12, 0x0095228, 0x0095328, 0x0095417, 0x0095617, 0x0095727,
+    0x0095B18, 0x0095E28, 0x0095F28, 0x0096528, 0x0096628, 0x0096727, 0x0096927, 0x0096A28,
+    0x0096C10, 0x0096E18, 0x0096F18, 0x0097210, 0x0097310, 0x0097518, 0x0097618, 0x0097A17,
+    0x0098103, 0x0098218, 0x0098824, 0x0098924, 0x0098A20, 0x0098C23, 0x0098D03, 0x0099424,
+    0x0099524, 0x0099B24, 0x0099C24, 0x0099D24, 0x0099F04, 0x009A024, 0x009A423, 0x009A528,
+    0x009AB28, 0x009AC18, 0x009B023, 0x009B812, 0x009B922, 0x009BF28, 0x009C020, 0x009C120,
+    0x009C402, 0x009CB14, 0x009D304, 0x009D624, 0x009D724, 0x009D820, 0x009D928, 0x009DC04,
+    0x009DF28, 0x009E218, 0x009E328, 0x009E420, 0x009EC24, 0x009ED24, 0x009F024, 0x009F124,
+    0x009F324, 0x009F424, 0x009F824, 0x009FC24, 0x009FD24, 0x009FF24, 0x00A0024, 0x00A0324,
+    0x00A0624, 0x00A0724, 0x00A0824, 0x00A0A24, 0x00A0B24, 0x00A1004, 0x00A1404, 0x00A1604,
+    0x00A1724, 0x00A2422, 0x00A2522, 0x00A2B02, 0x00A2C22, 0x00A2D22, 0x00A2F02, 0x00A3022,
+    0x00A4728, 0x00A4808, 0x00A4E27, 0x00A4F28, 0x00A5000, 0x00A5228, 0x00A5328, 0x00A5B22,
+    0x00A6300, 0x00A6622, 0x00A6722, 0x00A7B28, 0x00A7E08, 0x00A7F28, 0x00A8528, 0x00A8620,
+    0x00A8720, 0x00A8F02, 0x00A9022, 0x00A9300, 0x00A9622, 0x00A9702, 0x00A9822, 0x00A9A22,
+    0x00A9B02, 0x00AB028, 0x00AB228, 0x00AB328, 0x00AB627, 0x00AB728, 0x00AB928, 0x00ABA27,
+    0x00ABE28, 0x00AC423, 0x00AC523, 0x00ACB23, 0x00ACC02, 0x00AD023, 0x00AD723, 0x00AD808,
+    0x00ADE08, 0x00ADF28, 0x00AE000, 0x00AE223, 0x00AE323, 0x00AE823, 0x00AEE23, 0x00AEF28,
+    0x00AFC18, 0x00AFF10, 0x00B0218, 0x00B0328, 0x00B0420, 0x00B0E18, 0x00B0F28, 0x00B1528,
+    0x00B1620, 0x00B1727, 0x00B1A08, 0x00B1C20, 0x00B2220, 0x00B2328, 0x00B2618, 0x00B8A04,
+    0x00B8E14, 0x00B9024, 0x00B9124, 0x00BC424, 0x00BC524, 0x00BC724, 0x00BC824, 0x00BCC24,
+    0x00C2A11, 0x00C2C28, 0x00C2D28, 0x00C3027, 0x00C3117, 0x00C3308, 0x00C3427, 0x00C3828,
+    0x00C6700, 0x00C6A25, 0x00C6B08, 0x00C6C25, 0x00C6E28, 0x00C6F08, 0x00D4E03, 0x00D5120,
+    0x00D5403, 0x00D5523, 0x00D5614, 0x00D5824, 0x00D5924, 0x00D6028, 0x00D6123, 0x00D6723,
+    0x00D6828, 0x00D6928, 0x00D6B18, 0x00D6C28, 0x00D7024, 0x00D7124, 0x00D7424, 0x00D7524,
+    0x00D7724, 0x00D7804, 0x00D7C24, 0x00D8424, 0x00D8524, 0x00D8B24, 0x00D8C24, 0x00D8D24,
+    0x00D8F24, 0x00D9024, 0x00D9704, 0x00D9F04, 0x00DA224, 0x00DA304, 0x00DA424, 0x00DA524,
+    0x00DA724, 0x00DA824, 0x00DAB24, 0x00DAE24, 0x00DAF24, 0x00DB024, 0x00DB224, 0x00DB324,
+    0x00DBC20, 0x00DBD20, 0x00DBF02, 0x00DC428, 0x00DCB04, 0x00DCF20, 0x00DD428, 0x00DD628,
+    0x00DD718, 0x00DDC14, 0x00DE004, 0x00DE224, 0x00DE324, 0x00DF023, 0x00DF123, 0x00DF723,
+    0x00DF823, 0x00DF913, 0x00DFB02, 0x00DFC23, 0x00E0323, 0x00E0B00, 0x00E0E28, 0x00E0F23,
+    0x00E1308, 0x00E1423, 0x00E1700, 0x00E1A23, 0x00E1B23, 0x00E1C23, 0x00E1E28, 0x00E1F08,
+    0x00E5F20, 0x00E6410, 0x00E6628, 0x00E6718, 0x00E7628, 0x00E7720, 0x00E7918, 0x00E7C10,
+    0x00E7E28, 0x00E7F18, 0x00E8227, 0x00E8320, 0x00E8508, 0x00E8A28, 0x00E9422, 0x00E9522,
+    0x00E9722, 0x00E9802, 0x00E9C02, 0x00EA308, 0x00EA428, 0x00EA700, 0x00EAA28, 0x00EAB28,
+    0x00EAC28, 0x00EAE28, 0x00EAF27, 0x00EC802, 0x00ECB22, 0x00ECE02, 0x00ECF22, 0x00ED000,
+    0x00ED202, 0x00ED322, 0x00EDA28, 0x00EDB28, 0x00EE128, 0x00EE228, 0x00EE327, 0x00EE527,
+    0x00EE628, 0x00F0000, 0x00F0222, 0x00F0322, 0x00F0E28, 0x00F0F08, 0x00F1220, 0x00F1320,
+    0x00F1A28, 0x00F3822, 0x00F3922, 0x00F4421, 0x00F4511, 0x00F4C03, 0x00F5014, 0x00F5C04,
+    0x00F6C14, 0x00F6D22, 0x00F6F22, 0x00F7014, 0x00F7404, 0x00F7B11, 0x00F7C14, 0x00F7F10,
+    0x00F8214, 0x00F8328, 0x00F8414, 0x00F8614, 0x00F8727, 0x00F8C04, 0x00F9004, 0x00F9204,
+    0x00F9324, 0x00FA422, 0x00FB021, 0x00FB420, 0x00FDB02, 0x00FDC27, 0x00FE028, 0x00FE708,
+    0x00FE813, 0x00FEE27, 0x00FEF23, 0x00FF010, 0x00FF228, 0x00FF318, 0x00FF828, 0x00FFE28,
+    0x00FFF28, 0x0100C12, 0x0100F17, 0x0101227, 0x0101317, 0x0101412, 0x0101628, 0x0101728,
+    0x0101E18, 0x0101F18, 0x0102517, 0x0102610, 0x0102710, 0x0102918, 0x0102A18, 0x0102E28,
+    0x0102F28, 0x0103227, 0x0103328, 0x0103528, 0x0103627, 0x0103A28, 0x0104427, 0x0104622,
+    0x0104702, 0x0105228, 0x0105308, 0x0105620, 0x0105720, 0x0105E28, 0x0106A28, 0x0107C22,
+    0x0108821, 0x010B012, 0x010B222, 0x010B322, 0x010BE21, 0x010BF11, 0x010C220, 0x010C310,
+    0x010C618, 0x010CA17, 0x0134322, 0x0135B21, 0x0137428, 0x0137520, 0x0137718, 0x0137804,
+    0x0137F26, 0x0138718, 0x0138A28, 0x0138B26, 0x0138F14, 0x0139004, 0x0139314, 0x0139624,
+    0x0139726, 0x0139810, 0x0139A28, 0x0139B14, 0x0141720, 0x0141A02, 0x0141B22, 0x0142D26,
+    0x0143221, 0x0143326, 0x0143A10, 0x0143B20, 0x0143D18, 0x0148320, 0x0148602, 0x0148722,
+    0x0149928, 0x0149E06, 0x0149F26, 0x014A526, 0x014B828, 0x014BA28, 0x014BB12, 0x014C228,
+    0x014C326, 0x014C926, 0x014CA28, 0x014CB18, 0x014CD18, 0x014CE28, 0x014D216, 0x014D326,
+    0x014D616, 0x014D726, 0x014D926, 0x014DA06, 0x014DE16, 0x0155424, 0x0155524, 0x0155724,
+    0x0155824, 0x0155C14, 0x0156324, 0x0156404, 0x0156A24, 0x0156B24, 0x0156E24, 0x0156F24,
+    0x015FC26, 0x015FE28, 0x015FF18, 0x0160626, 0x0160726, 0x0161106, 0x0161226, 0x018D721,
+    0x0193D04, 0x0194228, 0x0194321, 0x0194904, 0x0194A28, 0x0194B20, 0x0194D18, 0x019E521,
+    0x019ED20, 0x01A1528, 0x01A1A28, 0x01A1B28, 0x01A2128, 0x01A2508, 0x01A5128, 0x01A5920,
+    0x01A7D18, 0x01A8028, 0x01A8128, 0x01A8518, 0x01A8628, 0x01A8918, 0x01A8C28, 0x01A8D28,
+    0x01A8E28, 0x01A9028, 0x01A9118, 0x01A9F04, 0x01AA304, 0x01AA428, 0x01AAB04, 0x01AB624,
+    0x01AB704, 0x01ABB28, 0x01ABC28, 0x01AC224, 0x01AC328, 0x01AC628, 0x01AC728, 0x01AD704,
+    0x01ADA28, 0x01ADB22, 0x01AED04, 0x01AF228, 0x01AF328, 0x01AF928, 0x01AFA20, 0x01AFB20,
+    0x01B0A24, 0x01B0B24, 0x01B0C28, 0x01B0E28, 0x01B0F24, 0x01B1624, 0x01B1724, 0x01B1D24,
+    0x01B1E24, 0x01B1F24, 0x01B2124, 0x01B2224, 0x01B2628, 0x01B2724, 0x01B2A24, 0x01B2B24,
+    0x01B2D24, 0x01B2E24, 0x01B3228, 0x01B4622, 0x01B4722, 0x01B5E28, 0x01B5F28, 0x01B6928,
+    0x01B7D22, 0x01B9528, 0x01B9D20, 0x01BAE22, 0x01BAF00, 0x01BB102, 0x01BB222, 0x01BC928,
+    0x01BCA28, 0x01BD228, 0x01BD428, 0x01BD528, 0x01BE228, 0x01BE328, 0x01BE628, 0x01BE723,
+    0x01BEE28, 0x01BEF28, 0x01BF528, 0x01BF923, 0x01BFA28, 0x01BFE28, 0x01BFF28, 0x01C0528,
+    0x01C0628, 0x01C0A28, 0x01C1928, 0x01C1A20, 0x01C1B00, 0x01C1E28, 0x01C2528, 0x01C2D00,
+    0x01C3028, 0x01C3128, 0x01C3628, 0x01C3C28, 0x01C3D28, 0x01C3E20, 0x01E8724, 0x01E8804,
+    0x01E8E24, 0x01E8F24, 0x01E9224, 0x01E9324, 0x01EC524, 0x01EC624, 0x01EC724, 0x01EC924,
+    0x01EFE14, 0x01F2A21, 0x01F2B21, 0x01F3508, 0x01F9E10, 0x01FA028, 0x01FA118, 0x0205024,
+    0x0205414, 0x0205B11, 0x0205C13, 0x0206224, 0x0206323, 0x0206614, 0x0206714, 0x0206C04,
+    0x0207224, 0x0207324, 0x0208624, 0x0208724, 0x0208812, 0x0208A14, 0x0208B22, 0x0209214,
+    0x0209314, 0x0209914, 0x0209A14, 0x0209B14, 0x0209D14, 0x0209E14, 0x020A204, 0x020A324,
+    0x020A924, 0x020AA24, 0x020AE04, 0x020C621, 0x020C724, 0x020D214, 0x020DE24, 0x020F628,
+    0x020F718, 0x020FE21, 0x020FF23, 0x0210918, 0x0210A13, 0x0210E28, 0x0210F28, 0x0211A28,
+    0x0212A10, 0x0212B22, 0x0212D18, 0x0212E12, 0x0213511, 0x0213D10, 0x0214018, 0x0214118,
+    0x0214528, 0x0214621, 0x0214E00, 0x0215028, 0x0215128, 0x0216228, 0x0216908, 0x0217210,
+    0x0217428, 0x0217518, 0x0217A28, 0x0219E21, 0x0219F23, 0x021A608, 0x021AA13, 0x021CA02,
+    0x021CE12, 0x021D511, 0x021D618, 0x021DC18, 0x021DD28, 0x021DE10, 0x021E018, 0x021E118,
+    0x0267821, 0x0271A26, 0x0271B06, 0x0272226, 0x0272626, 0x02BBF04, 0x02BC024, 0x02BC624,
+    0x02BC724, 0x02BCA24, 0x02BCB24, 0x02BD023, 0x02BD623, 0x02BD728, 0x02BFD14, 0x02C0224,
+    0x02C0E18, 0x02C3624, 0x02C4204, 0x02C7228, 0x02C7328, 0x02C7928, 0x02C7A18, 0x02C7E28,
+    0x02CAA08, 0x02CB018, 0x02CB128, 0x02CDE28, 0x02CE428, 0x02CE528, 0x02D0221, 0x02D0321,
+    0x02D0A08, 0x02D1A23, 0x02D4018, 0x02D4128, 0x031BE04, 0x0322A28, 0x0326028, 0x0326128,
+    0x0391704, 0x0391C27, 0x0391D21, 0x0392317, 0x0395321, 0x0398224, 0x0398304, 0x0398704,
+    0x0398827, 0x0398E27, 0x0398F17, 0x0399224, 0x0399304, 0x039BF21, 0x03A2A27, 0x03A2B21,
+    0x03A3117, 0x03A4F01, 0x03A5A25, 0x03A5B27, 0x03A6027, 0x03A6627, 0x03A6717, 0x03A9127,
+    0x03A9627, 0x03A9721, 0x03A9D17, 0x03AC525, 0x03AC625, 0x03ACA27, 0x03ACB25, 0x03AD125,
+    0x03AD227, 0x03AD627, 0x03B6E27, 0x03B6F21, 0x03B7517, 0x03B7904, 0x03C1121, 0x03C7D21,
+    0x03CB117, 0x03CB227, 0x03CB827, 0x03CB917, 0x03CBC27, 0x03CBD27, 0x03D4224, 0x03D4324,
+    0x03D4924, 0x03D4D24, 0x03D4E24, 0x03D5A27, 0x03DF627, 0x03DFC27, 0x03DFD17, 0x03ECC24,
+    0x03ECD24, 0x03ED324, 0x03ED404, 0x03ED824, 0x03F0A24, 0x03F0B24, 0x03F0E24, 0x03F0F24,
+    0x03F7001, 0x03F7627, 0x03F7723, 0x03FAD05, 0x040B404, 0x040BA04, 0x040BB24, 0x040BE24,
+    0x040BF24, 0x040EA24, 0x040EB24, 0x040F124, 0x040F524, 0x0411E24, 0x0411F24, 0x0412524,
+    0x0412A24, 0x0415623, 0x0415721, 0x0415D23, 0x0428813, 0x0428E13, 0x0428F23, 0x0429224,
+    0x0429324, 0x042BE14, 0x042BF14, 0x042C514, 0x042C914, 0x042CA14, 0x042D524, 0x042D614,
+    0x042DA24, 0x042FE24, 0x0430A24, 0x0432A13, 0x0432B23, 0x0433123, 0x0433613, 0x0434227,
+    0x0436111, 0x0436C17, 0x0436D17, 0x0437211, 0x0437827, 0x0437917, 0x043D213, 0x043D603,
+    0x0440211, 0x0440817, 0x0440917, 0x0440C17, 0x0440D27, 0x051CA04, 0x051CB24, 0x051D124,
+    0x0524024, 0x0524124, 0x0526D21, 0x053A523, 0x053AA13, 0x053B624, 0x053E014, 0x053E114,
+    0x053E604, 0x053EC24, 0x053ED24, 0x053F024, 0x053F124, 0x0541424, 0x0541524, 0x0542024,
+    0x0542124, 0x0544C13, 0x0544D23, 0x0545221, 0x0548821, 0x0548921, 0x054E813, 0x054E923,
+    0x05F7824, 0x05F7924, 0x072EE25, 0x0743224, 0x0854824, 0x0854924,
+};
+
+#endif
@@ -11,6 +11,9 @@
  * - Windows + Dev-C++: Open 'c3.c' and hit F11
  * - DOS + DJGPP      : Type 'make'
  * -------------------------------------------------
+ * Batch analysis, no game screen:
+ *   c3 --batch [-d depth] [-t ms] [-j threads] [-e engine] [file]
+ * -------------------------------------------------
  * Changes:
  * - Removed DOS support
  * - Removed Windows 7 support
@@ -23,12 +26,49 @@
  * - Tested utilities added
  * - Game engine optimized for faster runtime
  * - Improved AI move ordering
+ * - Bitboard board representation
+ * - Pacifier bar drawn by its own thread, the search never sleeps
+ * - Root moves searched in parallel on every core
+ * - Lazy SMP search over a lock-free shared transposition table
+ * - Timed level: iterative deepening within a per-move time budget
+ * - Principal variation search with aspiration windows at the root
+ * - Move ordering by table move, killers, history and board centrality
+ * - Symmetric positions share table entries, symmetric root moves pruned
+ * - Perfect play table for 3x3 generated at build time, no search needed
+ * - Solved 4x4 database, memory-mapped and shared by every running game
+ * - Multi-threaded retrograde solver with work stealing behind the database
+ * - Heuristic evaluation of open lines at the search horizon, sooner wins preferred
+ * - k-in-a-row rules with local move generation and a continuous fours search
+ * - Monte Carlo tree search engine, tree reused between moves
+ * - Tree-parallel Monte Carlo search with virtual loss, or root-parallel
+ * - Proof-number search (PN2) for forced wins, "am I lost?" during play
+ * - Search benchmark over a fixed corpus with a regression baseline
+ * - Search statistics per ply, dumped as CSV or JSON ('make stats')
+ * - Headless batch analysis of positions on every core ('c3 --batch')
+ * - Self-play tournaments between engines, the computer plays X or O
+ * - Search engines registered by name and switched at run time
 */
 #include "game.h"
+#include "batch.h"
 
-int main() {
+int main(int argc, char ** argv) {
     bool keep_playing = true;
+    solved_db solved;
+    char path[32];
+    int code;
     
+    db_path(path);                          /* built by 'make db' */
+    if (argc > 1 && !strcmp(argv[1], "--batch")) {
+        code = batch_main(argc - 1, argv + 1, db_open(&solved, path) ? &solved : NULL);
+        db_close(&solved);
+        return code;
+    }
+    engine_init(&engine, TT_DEFAULT_MB);    /* settings and table size */
+    engine_set_threads(&engine, cpu_count());
+    if (db_open(&solved, path)) engine.db = &solved;
+#ifdef _USE_SEARCH_STATS_
+    stats_open(&engine, getenv("C3_STATS"));   /* C3_STATS=moves.csv or moves.json */
+#endif
     while (keep_playing) {
         if (game_init()) {
             game_close(game_play());
@@ -38,5 +78,10 @@ int main() {
         }
     }
     
+#ifdef _USE_SEARCH_STATS_
+    stats_close(&engine);
+#endif
+    engine_free(&engine);
+    db_close(&solved);
     return 0;
 }
@@ -0,0 +1,166 @@
+/*
+ * DB.H: Tic-Tac-Toe AI solved position database
+ * -----
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ */
+#ifndef _TICTACTOE_MINIMAX_DB_H_
+#define _TICTACTOE_MINIMAX_DB_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "defs.h"
+#include "board.h"
+
+/* The database holds the value of every position with X to move, 2 bits
+ * each, indexed by the base-3 code of the board. Positions with O to move
+ * are looked up with the colors swapped. It is built by tools/solve.c.
+ * On POSIX systems the file is mapped read-only, so every game running
+ * on the machine shares the same pages; elsewhere it is read in.
+ */
+#ifndef _WIN32
+    #ifndef __DJGPP__
+        #define _USE_MMAP_
+        #include <fcntl.h>
+        #include <unistd.h>
+        #include <sys/mman.h>
+    #endif
+#endif
+
+#define DB_MAGIC        "C3DB"
+#define DB_HEADER       16              /* magic, board size, code count, win length */
+#define DB_BYTES(codes) (((codes) + 3) / 4)
+
+typedef enum {                      /* value for the side to move */
+    DB_NONE, DB_LOSS, DB_DRAW, DB_WIN
+} db_value;
+
+/* =============== PROTOTYPES ==================== */
+
+void db_path(char * path);
+
+bool db_open(solved_db * db, const char * path);
+
+void db_close(solved_db * db);
+
+int db_get(const uint8_t * values, uint64_t code);
+
+int db_lookup(solved_db * db, bitmask mover, bitmask other);
+
+int db_probe(solved_db * db, game_board * g, char piece, int * score);
+
+/* =============================================== */
+
+/* file name of the database for this board size */
+void db_path(char * path) {
+    if (K_IN_A_ROW) sprintf(path, "c3_%dx%d_k%d.db", BOARD_SIZE, BOARD_SIZE, WIN_LENGTH);
+    else            sprintf(path, "c3_%dx%d.db", BOARD_SIZE, BOARD_SIZE);
+}
+
+bool db_open(solved_db * db, const char * path) {
+    uint8_t header[DB_HEADER];
+    uint32_t size, codes, length;
+    FILE * f;
+
+    init_masks();                       /* for pow3[] */
+    memset(db, 0, sizeof(solved_db));
+    if (!(f = fopen(path, "rb"))) return false;
+    if (fread(header, 1, DB_HEADER, f) != DB_HEADER) {
+        fclose(f);
+        return false;
+    }
+    memcpy(&size, header + 4, 4);
+    memcpy(&codes, header + 8, 4);
+    memcpy(&length, header + 12, 4);
+    if (memcmp(header, DB_MAGIC, 4) != 0 || size != BOARD_SIZE || length != WIN_LENGTH
+    ||  CELL_COUNT > 20 || codes != pow3[CELL_COUNT - 1] * 3) {
+        fclose(f);                      /* not for this board */
+        return false;
+    }
+    db->codes = codes;
+    db->length = DB_HEADER + DB_BYTES(codes);
+#ifdef _USE_MMAP_
+    fclose(f);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    db->memory = mmap(NULL, db->length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);                          /* the mapping stays */
+    if (db->memory == MAP_FAILED) {
+        db->memory = NULL;
+        return false;
+    }
+#else
+    db->memory = malloc(db->length);
+    if (!db->memory || fseek(f, 0, SEEK_SET) != 0
+    ||  fread(db->memory, 1, db->length, f) != db->length) {
+        free(db->memory);
+        db->memory = NULL;
+        fclose(f);
+        return false;
+    }
+    fclose(f);
+#endif
+    db->values = (const uint8_t *)db->memory + DB_HEADER;
+    return true;
+}
+
+void db_close(solved_db * db) {
+    if (!db->memory) return;
+#ifdef _USE_MMAP_
+    munmap(db->memory, db->length);
+#else
+    free(db->memory);
+#endif
+    memset(db, 0, sizeof(solved_db));
+}
+
+/* value stored for a code */
+int db_get(const uint8_t * values, uint64_t code) {
+    return (values[code >> 2] >> ((code & 3) * 2)) & 3;
+}
+
+/* value of a position for the side owning 'mover', which is to move */
+int db_lookup(solved_db * db, bitmask mover, bitmask other) {
+    uint64_t code = 0;
+    for (bitmask m = mover; m; m &= m - 1) code += pow3[bit_scan(m)];
+    for (bitmask m = other; m; m &= m - 1) code += 2 * pow3[bit_scan(m)];
+    return db_get(db->values, code);
+}
+
+/* best move for 'piece' by looking up every reply, -1 if the position is
+ * not in the database; 'score' gets the value the way the search scores it
+ */
+int db_probe(solved_db * db, game_board * g, char piece, int * score) {
+    bitmask mine = piece == CELL_X ? g->x : g->o;
+    bitmask theirs = piece == CELL_X ? g->o : g->x;
+    int sq, v, value = DB_NONE, best = -1;
+
+    if (!db || !db->values || db_lookup(db, mine, theirs) == DB_NONE) return -1;
+    for (int i = 0; i < CELL_COUNT; i++) {
+        sq = move_order[i];
+        if (!(empty_cells(g) & ((bitmask)1 << sq))) continue;
+        place(g, sq, piece);
+        if (wins_at(g, sq, piece)) {    /* nothing beats winning now */
+            unplace(g, sq, piece);
+            value = DB_WIN;
+            best = sq;
+            break;
+        }
+        if (!empty_cells(g)) v = DB_DRAW;
+        else {                          /* the other side's value, turned */
+            v = db_lookup(db, theirs, mine | ((bitmask)1 << sq));
+            v = v == DB_WIN ? DB_LOSS : v == DB_LOSS ? DB_WIN : v;
+        }
+        unplace(g, sq, piece);
+        if (v > value) {
+            value = v;
+            best = sq;
+        }
+    }
+    *score = value == DB_WIN ? piece_score(piece)
+           : value == DB_LOSS ? -piece_score(piece) : SCORE_TIE;
+    return best;
+}
+
+#endif
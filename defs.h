@@ -2,34 +2,51 @@
  * DEFS.H: Tic-Tac-Toe AI global definitions 
  * -------
  * Coded by Trinh D.D. Nguyen
- * Last updates: Nov, 2025
+ * Last updates: Oct, 2026
  */
 #ifndef _TICTACTOE_MINIMAX_DEFS_H_
 #define _TICTACTOE_MINIMAX_DEFS_H_
 
-/* Alpha-Beta pruning strategy:
- * enable to compact the search space for faster runtime
+#include <stddef.h>
+#include <stdint.h>
+
+/* Search statistics:
+ * enable to count nodes, cutoffs and table traffic per ply, see stats.h
  */
-#define _USE_ALPHA_BETA_PRUNE_
+/* #define _USE_SEARCH_STATS_ */
 
+#ifndef BOARD_SIZE
 #define BOARD_SIZE      3                  /* board size, default at 3 */
+#endif
+#ifndef WIN_LENGTH
+#define WIN_LENGTH      BOARD_SIZE         /* pieces in a row that win */
+#endif
+#if WIN_LENGTH > BOARD_SIZE || WIN_LENGTH < 3
+    #error "WIN_LENGTH must be from 3 to BOARD_SIZE"
+#endif
+#define CELL_COUNT      (BOARD_SIZE * BOARD_SIZE)
+#define WIN_SPAN        (BOARD_SIZE - WIN_LENGTH + 1)  /* windows along a full line */
+#define LINE_COUNT      (2 * BOARD_SIZE * WIN_SPAN + 2 * WIN_SPAN * WIN_SPAN)
+                                           /* windows on rows, columns, diagonals */
+#define K_IN_A_ROW      (WIN_LENGTH < BOARD_SIZE)  /* Gomoku style rules */
+#define SYMMETRIES      8                  /* rotations and reflections */
 #define GAME_EASY       2
 #define GAME_MEDIUM     3
 #define GAME_HARD       5
 #define GAME_IMPOSSIBLE 6
+#define GAME_TIME_MS    1000               /* budget of a timed move */
 #define GAME_VERSION    0x0400             /* game version */
-#ifdef  _USE_ALPHA_BETA_PRUNE_
-    #define GAME_ENGINE     "ABPRUNE"
-#else
-    #define GAME_ENGINE     "MINIMAX"
-#endif
+#define MAX_THREADS     64                 /* search threads per context */
 
 #define CELL_X          ('X')              /* cross piece */
 #define CELL_O          ('O')              /* nought piece */
 #define CELL_E          (0)                /* empty cell */
-#define SCORE_X         (+1)               /* evaluation score for X */
-#define SCORE_O         (-1)               /* evaluation score for O */
+#define SCORE_WIN       1000000            /* a won game, less its length */
+#define SCORE_X         (+SCORE_WIN)       /* evaluation score for X */
+#define SCORE_O         (-SCORE_WIN)       /* evaluation score for O */
 #define SCORE_TIE       (0)                /* no winner found, tie */
+#define SCORE_MATE      (SCORE_WIN - 64)   /* beyond: a win within the horizon */
+#define SCORE_UNKNOWN   (SCORE_WIN + 2)    /* a move picked without a score */
 
 #ifndef __DJGPP__
 	#define C_X             "\x1b[38;5;20m"
@@ -71,24 +88,210 @@ typedef struct mv {                 /* store the best move found */
     int r, c;                       /* only used by the AI */
 } move;
 
-typedef char game_board[BOARD_SIZE][BOARD_SIZE];
+/* bitboard word: one bit per cell, cell index is r * BOARD_SIZE + c */
+#if   CELL_COUNT <= 16
+typedef uint16_t bitmask;
+#elif CELL_COUNT <= 32
+typedef uint32_t bitmask;
+#elif CELL_COUNT <= 64
+typedef uint64_t bitmask;
+#else
+    #error "BOARD_SIZE must not exceed 8"
+#endif
+
+typedef struct {                    /* game board as one bitmask per side */
+    bitmask x;                      /* cells taken by X */
+    bitmask o;                      /* cells taken by O */
+    uint64_t keys[SYMMETRIES];      /* Zobrist keys of the board seen through
+                                       each symmetry, [0] = as it is */
+    uint8_t count[2][LINE_COUNT];   /* pieces per line, [0] = X, [1] = O */
+    int heuristic;                  /* open line score, X positive */
+} game_board;
 
 /* Transposition table for memoization */
-#define TRANS_TABLE_SIZE 19683  /* 3^9 for 3x3 board */
-typedef struct {
-    unsigned int hash;
-    int score;
-    char depth;
+#if BOARD_SIZE <= 3
+    #define TT_DEFAULT_MB   1               /* default table size in MB */
+#else
+    #define TT_DEFAULT_MB   16
+#endif
+#define TT_BUCKET_SIZE  4                   /* entries per 64-byte bucket */
+#define TT_NO_MOVE      0xFF                /* entry has no best move */
+
+typedef enum {                      /* meaning of a stored score */
+    BOUND_NONE, BOUND_EXACT, BOUND_LOWER, BOUND_UPPER
+} tt_bound;
+
+typedef enum {                      /* what a store did to the table */
+    TT_KEPT,                        /* a deeper result was kept instead */
+    TT_STORED,                      /* into a free slot or over the same position */
+    TT_REPLACED                     /* over another position */
+} tt_store;
+
+typedef struct {                    /* one table entry, 16 bytes */
+    uint64_t key;                   /* full key ^ data, torn writes fail to verify */
+    uint64_t data;                  /* score, move, depth, bound and age */
 } trans_entry;
 
-char human = CELL_O;                /* human player symbol */
-char computer = CELL_X;             /* computer symbol */
-char current;                       /* current turn */
-int game_depth = GAME_MEDIUM;       /* AI level */
-game_board board;                   /* empty game board */
-int states = 0;                     /* searched state counter */
-int move_count = 0;                 /* number of moves made */
-trans_entry trans_table[TRANS_TABLE_SIZE];  /* transposition table */
+typedef struct {                    /* entries sharing one cache line */
+    trans_entry entry[TT_BUCKET_SIZE];
+} trans_bucket;
+
+typedef struct {                    /* transposition table */
+    trans_bucket * buckets;         /* cache line aligned buckets */
+    size_t mask;                    /* bucket count - 1 */
+    int age;                        /* search generation */
+    void * memory;                  /* unaligned block behind the buckets */
+} trans_table;
+
+typedef struct {                    /* live search figures, read by the renderer */
+    long nodes;                     /* search states explored so far */
+    int depth;                      /* depth being searched */
+    int best;                       /* best root move so far, -1 if none */
+} search_info;
+
+typedef struct {                    /* root moves shared by parallel workers */
+    struct engine_ctx * ctx;        /* context that started the search */
+    int moves[CELL_COUNT];          /* root moves in priority order */
+    int n;                          /* number of root moves */
+    int next;                       /* next root move to hand out */
+    int alpha, beta;                /* root window */
+    uint64_t best;                  /* best (score, priority) found so far */
+} root_split;
+
+typedef enum {                      /* how extra threads share a search */
+    SMP_SPLIT,                      /* root moves handed out one by one */
+    SMP_LAZY                        /* every thread searches the whole tree */
+} smp_mode;
+
+typedef struct {                    /* an opened solved position database */
+    const uint8_t * values;         /* 2 bits per code */
+    uint64_t codes;                 /* number of codes, 3^CELL_COUNT */
+    void * memory;                  /* mapping or buffer behind 'values' */
+    size_t length;                  /* bytes of 'memory' */
+} solved_db;
+
+typedef struct {                    /* figures of one solved layer */
+    int64_t positions;              /* positions given a value */
+    int64_t ms;                     /* time spent on the layer */
+} solver_layer;
+
+typedef struct {                    /* retrograde solver of the whole board */
+    uint8_t * values;               /* 2 bits per code, as in the database */
+    uint32_t codes;                 /* number of codes, 3^CELL_COUNT */
+    uint32_t * code3;               /* base-3 code of each single side mask */
+    int * masks;                    /* side masks ordered by piece count */
+    int starts[CELL_COUNT + 2];     /* first mask of each piece count */
+    int threads;                    /* workers of each layer */
+    int layer;                      /* pieces on the boards being solved */
+    uint64_t ranges[MAX_THREADS];   /* masks left to each worker, packed */
+    int64_t positions;              /* solved so far in the running layer */
+    solver_layer stats[CELL_COUNT + 1]; /* figures by piece count */
+    int64_t ms;                     /* time spent on all layers */
+} solver_ctx;
+
+typedef struct {                    /* what an engine tells of its last move */
+    int64_t nodes;                  /* states, playouts or proof nodes */
+    int depth;                      /* ply limit searched to, 0 = no plies */
+    int64_t tt_probes;              /* table lookups */
+    int64_t tt_hits;                /* lookups that made a search needless */
+} search_report;
+
+struct engine_ctx;
+
+typedef struct {                    /* a move picker, registered by name */
+    const char * name;              /* unique, any case for engine_find() */
+    const char * info;              /* one line about it */
+    bool (*init)(struct engine_ctx * ctx);      /* switched to, false if it cannot run */
+    int (*search)(struct engine_ctx * ctx, int * moves, int n, int * score);  /* one of 'moves' */
+    void (*stop)(struct engine_ctx * ctx);      /* end the running search, from any thread */
+    void (*stats)(struct engine_ctx * ctx, search_report * r);   /* of the last move */
+    void (*free)(struct engine_ctx * ctx);      /* switched from, or the context freed */
+} search_engine;
+
+typedef enum {                      /* how extra threads share a Monte Carlo search */
+    MCTS_SHARED,                    /* one tree, spread by virtual loss */
+    MCTS_ROOTS                      /* a tree each, root moves merged at the end */
+} mcts_mode;
+
+typedef struct {                    /* a position of the Monte Carlo tree, 16 bytes */
+    int32_t first;                  /* first of its children, -1 = not expanded */
+    int32_t visits;                 /* playouts through it */
+    int32_t score;                  /* 2 a win, 1 a draw, for the side that moved here */
+    uint8_t move;                   /* cell played to get here */
+    uint8_t count;                  /* number of children */
+    uint8_t state;                  /* mcts_state of the game after the move */
+    uint8_t spare;
+} mcts_node;
+
+typedef struct {                    /* Monte Carlo tree in one node arena */
+    mcts_node * nodes;              /* the arena, children are kept together */
+    int size;                       /* nodes in the arena */
+    int used;                       /* nodes handed out so far */
+    int root;                       /* node of the position searched from */
+    bitmask x, o;                   /* that position */
+    char mover;                     /* and the side to move there */
+    uint64_t seed;                  /* random playout state */
+} mcts_tree;
+
+#define STATS_PLIES     (CELL_COUNT + 1)    /* root and every ply below it */
+
+typedef struct {                    /* counters of the last move, see stats.h */
+    int64_t nodes[STATS_PLIES];     /* positions searched by ply, 0 = root */
+    int64_t leaves[STATS_PLIES];    /* positions scored at the horizon */
+    int64_t cutoffs[STATS_PLIES];   /* beta cutoffs */
+    int64_t first_cutoffs[STATS_PLIES]; /* of those, by the first move tried */
+    int64_t probes, hits;           /* table lookups and useful ones */
+    int64_t stores, overwrites;     /* table writes, and those over another position */
+    int iterations;                 /* deepening iterations finished */
+    int iter_depth[STATS_PLIES];    /* depth of each iteration */
+    int64_t iter_nodes[STATS_PLIES];/* nodes of each iteration */
+    int64_t iter_us[STATS_PLIES];   /* microseconds of each iteration */
+    int64_t start, us;              /* clock_us() at the start, time of the move */
+} search_stats;
+
+typedef struct engine_ctx {         /* engine context: one game, one search */
+    game_board board;               /* game board */
+    char human;                     /* human player symbol */
+    char computer;                  /* computer symbol */
+    char current;                   /* current turn */
+    int game_depth;                 /* AI level, the deepest ply to search */
+    int time_budget;                /* milliseconds a move, 0 = fixed depth */
+    int search_depth;               /* ply limit of the running iteration */
+    int64_t deadline;               /* clock_ms() to give up at, 0 = none */
+    int states;                     /* searched state counter */
+    int tt_probes;                  /* table lookups of the last move */
+    int tt_hits;                    /* lookups that made a search needless */
+    int move_count;                 /* number of moves made */
+    trans_table * tt;               /* table in use, may be shared */
+    trans_table own_tt;             /* table allocated by engine_init() */
+    search_info live;               /* published by the running search */
+    int threads;                    /* search threads, 1 = serial */
+    struct engine_ctx * helpers;    /* contexts of the extra threads */
+    root_split * split;             /* root moves being shared, if any */
+    int split_index;                /* root move this worker is on */
+    int smp;                        /* smp_mode of the extra threads */
+    int * stop;                     /* raised to abandon the running search */
+    int halt;                       /* the stop of select_move(), see engine_stop() */
+    bool prune;                     /* alpha-beta cutoffs, else plain minimax; set by the engine */
+    bool pvs;                       /* principal variation search, else plain alpha-beta */
+    int killers[CELL_COUNT][2];     /* last cutoff moves of each ply, -1 = none */
+    int history[2][CELL_COUNT];     /* cutoff credit of moves, [1] = computer's */
+    bool book;                      /* play solved positions from the table */
+    solved_db * db;                 /* solved position database, if opened */
+    const search_engine * search;   /* picks the moves, see engine_use() */
+    uint64_t rng;                   /* state of the Easy level's random moves, never 0 */
+    mcts_tree * mcts;               /* tree kept between moves, made on first use */
+    int playouts;                   /* Monte Carlo playouts a move, unless timed */
+    int mcts_mode;                  /* mcts_mode of the extra threads */
+    int pns_nodes;                  /* node cap of a proof-number search */
+#ifdef _USE_SEARCH_STATS_
+    search_stats stats;             /* counters of the last move */
+    void * stats_file;              /* FILE to dump them to after each move, if any */
+    int stats_format;               /* stats_format of the dump */
+#endif
+} engine_ctx;
+
+engine_ctx engine;                  /* the interactive game */
 
 #ifndef __DJGPP__
 char * logo = 
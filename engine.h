@@ -2,7 +2,7 @@
  * ENGINE.H: Tic-Tac-Toe AI MiniMax AI Core
  * ---------
  * Coded by Trinh D.D. Nguyen
- * Last updates: Nov, 2025
+ * Last updates: Oct, 2026
  */
 #ifndef _TICTACTOE_MINIMAX_ENGINE_H_
 #define _TICTACTOE_MINIMAX_ENGINE_H_
@@ -10,81 +10,249 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <ctype.h>
 #include "defs.h"
+#include "thread.h"
+#include "board.h"
+#include "ttable.h"
+#include "book.h"
+#include "db.h"
+#include "threat.h"
+#include "mcts.h"
+#include "pns.h"
+#include "stats.h"
+
+#define MIN_INF (-SCORE_WIN - 1)
+#define MAX_INF (+SCORE_WIN + 1)
+
+/* root split ordering: higher score first, then earlier root move */
+#define SPLIT_PACK(score, index) \
+            (((uint64_t)((score) - MIN_INF) << 32) | (uint32_t)(CELL_COUNT - (index)))
+#define SPLIT_SCORE(b)  ((int)((b) >> 32) + MIN_INF)
+#define SPLIT_INDEX(b)  (CELL_COUNT - (int)((b) & 0xFFFFFFFF))
+
+#define ASPIRATION      16              /* root window around the last score */
+#define ENGINE_MAX      16              /* search engines that can be registered */
+
+/* move ordering keys: static class, then history credit within a class */
+#define HISTORY_MAX     (1 << 20)
+#define ORDER_KEY(sq, h) ((CELL_COUNT - order_class[sq]) * (HISTORY_MAX + 1) + (h))
+#define ORDER_KILLER    ((CELL_COUNT + 1) * (HISTORY_MAX + 1))
+#define ORDER_HINT      (ORDER_KILLER + 2)
 
-#define MIN_INF (-1000)
-#define MAX_INF (+1000)
+/* =============== PROTOTYPES ==================== */
 
-/* Move ordering: prioritize center, corners, then edges */
-static const int move_priority[9] = {4, 0, 2, 6, 8, 1, 3, 5, 7};
+bool is_playable(game_board * g, int c, int r);
 
-/* =============== PROTOTYPES ==================== */
+bool is_occupied(game_board * g, int c, int r);
 
-unsigned int hash_board(game_board g);
+bool has_move(game_board * g);
 
-void clear_trans_table();
+void init_board(game_board * g);
 
-int lookup_trans_table(unsigned int hash, int depth);
+void show_board(game_board * g, bool final);
 
-bool is_playable(game_board g, int c, int r);
+int evaluate(game_board * g);
 
-bool is_occupied(game_board g, int c, int r);
+bool engine_init(engine_ctx * ctx, size_t tt_mb);
 
-bool has_move(game_board g);
+void engine_free(engine_ctx * ctx);
 
-void init_board(game_board g);
+bool engine_set_threads(engine_ctx * ctx, int threads);
 
-void show_board(game_board g, bool final);
+const char * engine_name(engine_ctx * ctx);
 
-int evaluate(game_board g);
+void new_game(engine_ctx * ctx);
 
-#ifdef _USE_ALPHA_BETA_PRUNE_
-    int minimax(game_board g, int depth, bool ismax, int alpha, int beta);
-#else
-    int minimax(game_board g, int depth, bool ismax);
-#endif
+void order_reset(engine_ctx * ctx);
+
+int minimax(engine_ctx * ctx, int depth, bool ismax, int alpha, int beta);
+
+int search_child(engine_ctx * ctx, int depth, bool ismax, int alpha, int beta, bool first);
+
+void order_moves(engine_ctx * ctx, int * moves, int n, int hint, int depth, bool ismax);
+
+void note_cutoff(engine_ctx * ctx, int depth, bool ismax, int sq);
+
+bool human_move(engine_ctx * ctx, int c, int r);
+
+int split_alpha(root_split * rs, int index);
+
+int split_root(engine_ctx * ctx, int * moves, int n, int alpha, int beta, int * score);
+
+int lazy_root(engine_ctx * ctx, int * moves, int n, int alpha, int beta, int * score);
+
+int serial_root(engine_ctx * ctx, int * moves, int n, int alpha, int beta, int * score);
+
+int search_root(engine_ctx * ctx, int * moves, int n, int alpha, int beta, int * score);
+
+int deepen_root(engine_ctx * ctx, int * moves, int n, int * result);
+
+int select_move(engine_ctx * ctx, int * score);
+
+void computer_move(engine_ctx * ctx);
+
+bool init_minimax(engine_ctx * ctx);
+
+bool init_alphabeta(engine_ctx * ctx);
+
+bool init_pvs(engine_ctx * ctx);
+
+int minimax_move(engine_ctx * ctx, int * moves, int n, int * score);
+
+int playout_move(engine_ctx * ctx, int * moves, int n, int * score);
+
+int proof_move(engine_ctx * ctx, int * moves, int n, int * score);
+
+void halt_search(engine_ctx * ctx);
+
+void report_search(engine_ctx * ctx, search_report * r);
+
+void report_playouts(engine_ctx * ctx, search_report * r);
+
+void free_none(engine_ctx * ctx);
 
-bool human_move(game_board g, int c, int r);
+void free_trees(engine_ctx * ctx);
 
-void computer_move(game_board g);
+bool engine_register(const search_engine * e);
+
+const search_engine * engine_find(const char * name);
+
+int engine_count();
+
+const search_engine * engine_at(int i);
+
+bool engine_use(engine_ctx * ctx, const search_engine * e);
+
+void engine_stop(engine_ctx * ctx);
+
+void engine_report(engine_ctx * ctx, search_report * r);
+
+extern const search_engine engine_pvs;
 
 /* =============================================== */
 
 /* check if a cell is empty */
-bool is_playable(game_board g, int c, int r) {
-    return g[r][c] == CELL_E;
+bool is_playable(game_board * g, int c, int r) {
+    return ((g->x | g->o) & cell_mask(c, r)) == 0;
 }
 
 /* check if a cell is occupied */
-bool is_occupied(game_board g, int c, int r) {
-    return g[r][c] != CELL_E;
+bool is_occupied(game_board * g, int c, int r) {
+    return ((g->x | g->o) & cell_mask(c, r)) != 0;
 }
 
 /* check if the board is still playable */
-bool has_move(game_board g) {
-    /* Fast path: use move counter if within valid range */
-    if (move_count >= 0 && move_count < BOARD_SIZE * BOARD_SIZE) {
-        return move_count < BOARD_SIZE * BOARD_SIZE;
-    }
-    /* Fallback: count empty cells (for tests that manually fill boards) */
-    int count = 0;
-    for (int r = 0; r < BOARD_SIZE; r++)
-        for (int c = 0; c < BOARD_SIZE; c++)
-            if (g[r][c] == CELL_E) count++;
-    return count > 0;
+bool has_move(game_board * g) {
+    return empty_cells(g) != 0;
 }
 
 /* initialize game board */
-void init_board(game_board g) {
-    for (int r = 0; r < BOARD_SIZE; r++)
-    for (int c = 0; c < BOARD_SIZE; c++)
-        g[r][c] = CELL_E;
-    move_count = 0;
-    clear_trans_table();
+void init_board(game_board * g) {
+    init_masks();
+    memset(g, 0, sizeof(game_board));  /* no pieces, counters and key */
+}
+
+/* set up a context with default settings and its own table */
+bool engine_init(engine_ctx * ctx, size_t tt_mb) {
+    memset(ctx, 0, sizeof(engine_ctx));
+    ctx->human = CELL_O;
+    ctx->computer = CELL_X;
+    ctx->current = CELL_O;
+    ctx->game_depth = GAME_MEDIUM;
+    ctx->threads = 1;
+    ctx->prune = true;
+    ctx->pvs = true;
+    ctx->book = true;
+    ctx->search = &engine_pvs;
+    ctx->search->init(ctx);
+    ctx->rng = 0x9E3779B97F4A7C15ULL;   /* the same moves until seeded */
+    ctx->playouts = MCTS_PLAYOUTS;
+    ctx->pns_nodes = PNS_NODES;
+    ctx->tt = &ctx->own_tt;
+    init_board(&ctx->board);
+    return tt_init(ctx->tt, tt_mb);
+}
+
+void engine_free(engine_ctx * ctx) {
+    if (ctx->search) ctx->search->free(ctx);
+    engine_set_threads(ctx, 1);
+    tt_free(&ctx->own_tt);
+    ctx->tt = NULL;
+    if (ctx->mcts) mcts_free(ctx->mcts);
+    free(ctx->mcts);
+    ctx->mcts = NULL;
+}
+
+/* set the search thread count, each extra thread gets a helper context
+ * that searches into the table of 'ctx'
+ */
+bool engine_set_threads(engine_ctx * ctx, int threads) {
+    int i;
+
+    for (i = 0; i < ctx->threads - 1; i++) engine_free(&ctx->helpers[i]);
+    free(ctx->helpers);
+    ctx->helpers = NULL;
+    ctx->threads = 1;
+    if (threads <= 1) return true;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    ctx->helpers = (engine_ctx *)calloc(threads - 1, sizeof(engine_ctx));
+    if (!ctx->helpers) return false;
+    for (i = 0; i < threads - 1; i++) {
+        ctx->helpers[i].threads = 1;
+        ctx->helpers[i].tt = ctx->tt;   /* one table for every thread */
+        init_board(&ctx->helpers[i].board);
+    }
+    ctx->threads = threads;
+    return true;
+}
+
+/* name of the search engine in use */
+const char * engine_name(engine_ctx * ctx) {
+    return ctx->search->name;
+}
+
+/* copy the position and settings of a context into a helper */
+void engine_sync(engine_ctx * helper, engine_ctx * ctx) {
+    helper->board = ctx->board;
+    helper->human = ctx->human;
+    helper->computer = ctx->computer;
+    helper->current = ctx->current;
+    helper->game_depth = ctx->game_depth;
+    helper->search_depth = ctx->search_depth;
+    helper->deadline = ctx->deadline;
+    helper->prune = ctx->prune;
+    helper->pvs = ctx->pvs;
+    order_reset(helper);
+    helper->move_count = ctx->move_count;
+    helper->tt = ctx->tt;
+    helper->states = 0;
+    helper->tt_probes = helper->tt_hits = 0;
+    STAT_RESET(helper);
+}
+
+/* forget the killers and let older history fade before a search */
+void order_reset(engine_ctx * ctx) {
+    memset(ctx->killers, 0xFF, sizeof(ctx->killers));
+    for (int i = 0; i < CELL_COUNT; i++) {
+        ctx->history[0][i] >>= 1;
+        ctx->history[1][i] >>= 1;
+    }
+}
+
+/* empty board, zero counters and a fresh table */
+void new_game(engine_ctx * ctx) {
+    init_board(&ctx->board);
+    ctx->move_count = 0;
+    ctx->states = 0;
+    clear_trans_table(ctx->tt);
 }
 
 /* display game board */
-void show_board(game_board g, bool final) {
+void show_board(game_board * g, bool final) {
+    char piece;
+
 
 #define HBAR    for (int c = 0; c < BOARD_SIZE; c++) \
                     printf(C_DARK"+-----"C_RESET);          \
@@ -93,11 +261,12 @@ void show_board(game_board g, bool final) {
     HBAR;
     for (int r = 0; r < BOARD_SIZE; r++) {
         for (int c = 0; c < BOARD_SIZE; c++) {
-            if (is_occupied(g, c, r)) {
-                if (g[r][c] == CELL_X)
-                    printf(C_DARK"| "C_X"%2c  "C_DARK, g[r][c]);
+            piece = get_cell(g, c, r);
+            if (piece != CELL_E) {
+                if (piece == CELL_X)
+                    printf(C_DARK"| "C_X"%2c  "C_DARK, piece);
                 else
-                    printf(C_DARK"| "C_O"%2c  "C_DARK, g[r][c]);
+                    printf(C_DARK"| "C_O"%2c  "C_DARK, piece);
             }
             else {
                 if (!final)
@@ -111,333 +280,647 @@ void show_board(game_board g, bool final) {
     }
 }
 
-/* ---------------------- */
-/* Transposition table functions */
-unsigned int hash_board(game_board g) {
-    unsigned int hash = 0;
-    unsigned int mult = 1;
-    for (int r = 0; r < BOARD_SIZE; r++) {
-        for (int c = 0; c < BOARD_SIZE; c++) {
-            int val = (g[r][c] == CELL_X) ? 1 : (g[r][c] == CELL_O) ? 2 : 0;
-            hash += val * mult;
-            mult *= 3;
-        }
+/* board evaluate function: X wins = SCORE_X, O wins = SCORE_O, else a tie */
+/* every line is a single mask test per side */
+int evaluate(game_board * g) {
+    for (int i = 0; i < LINE_COUNT; i++) {
+        if ((g->x & line_masks[i]) == line_masks[i]) return SCORE_X;
+        if ((g->o & line_masks[i]) == line_masks[i]) return SCORE_O;
     }
-    return hash;
+    return SCORE_TIE;
 }
 
-void clear_trans_table() {
-    for (int i = 0; i < TRANS_TABLE_SIZE; i++) {
-        trans_table[i].hash = 0;
-        trans_table[i].score = 0;
-        trans_table[i].depth = -1;
-    }
+int mini(int a, int b) {
+    return a < b ? a : b;
 }
 
-int lookup_trans_table(unsigned int hash, int depth) {
-    int idx = hash % TRANS_TABLE_SIZE;
-    if (trans_table[idx].hash == hash && trans_table[idx].depth >= depth) {
-        return trans_table[idx].score;
-    }
-    return MIN_INF - 1;  /* not found */
+int maxi(int a, int b) {
+    return a > b ? a : b;
 }
 
-void store_trans_table(unsigned int hash, int score, int depth) {
-    int idx = hash % TRANS_TABLE_SIZE;
-    if (trans_table[idx].depth <= depth) {
-        trans_table[idx].hash = hash;
-        trans_table[idx].score = score;
-        trans_table[idx].depth = depth;
+/* search one child of a node, 'ismax' being the child's side. Under PVS
+ * only the first child gets the full window, the others are searched with
+ * a null window to prove they are no better and re-searched if they are.
+ */
+int search_child(engine_ctx * ctx, int depth, bool ismax, int alpha, int beta, bool first) {
+    int score;
+    if (first || !ctx->pvs || !ctx->prune)
+        return minimax(ctx, depth, ismax, alpha, beta);
+
+    if (!ismax) {                           /* a maximizer's move */
+        score = minimax(ctx, depth, ismax, alpha, alpha + 1);
+        if (score <= alpha || score >= beta) return score;
     }
-}
-/* ---------------------- */
-
-/* board evaluate function: X wins = +1, O wins = -1, tie = 0 */
-/* Optimized with inlined logic for better performance */
-int evaluate(game_board g) {
-    int i, match;
-    
-    /* row checks - inlined */
-	for (int r = 0; r < BOARD_SIZE; r++) {
-        match = 1;
-        for (int c = 0; c < BOARD_SIZE && match; c++)
-            match = match && (g[r][c] == CELL_X);
-        if (match) return SCORE_X;
-        
-        match = 1;
-        for (int c = 0; c < BOARD_SIZE && match; c++)
-            match = match && (g[r][c] == CELL_O);
-        if (match) return SCORE_O;
+    else {                                  /* a minimizer's move */
+        score = minimax(ctx, depth, ismax, beta - 1, beta);
+        if (score >= beta || score <= alpha) return score;
     }
+    return minimax(ctx, depth, ismax, alpha, beta);     /* it was better: re-search */
+}
 
-    /* column checks - inlined */
-	for (int c = 0; c < BOARD_SIZE; c++) {
-        match = 1;
-        for (int r = 0; r < BOARD_SIZE && match; r++)
-            match = match && (g[r][c] == CELL_X);
-        if (match) return SCORE_X;
-        
-        match = 1;
-        for (int r = 0; r < BOARD_SIZE && match; r++)
-            match = match && (g[r][c] == CELL_O);
-        if (match) return SCORE_O;
+/* order the moves of a node: the table's move, the killers of this ply,
+ * then the static order with history deciding among alike cells
+ */
+void order_moves(engine_ctx * ctx, int * moves, int n, int hint, int depth, bool ismax) {
+    int keys[CELL_COUNT], i, j, sq, key;
+    int * killers = ctx->killers[depth];
+    int * history = ctx->history[ismax];
+
+    for (i = 0; i < n; i++) {
+        sq = moves[i];
+        if (sq == hint)             key = ORDER_HINT;
+        else if (sq == killers[0])  key = ORDER_KILLER + 1;
+        else if (sq == killers[1])  key = ORDER_KILLER;
+        else                        key = ORDER_KEY(sq, history[sq]);
+        for (j = i; j > 0 && keys[j-1] < key; j--) {    /* stable insertion */
+            keys[j] = keys[j-1];
+            moves[j] = moves[j-1];
+        }
+        keys[j] = key;
+        moves[j] = sq;
     }
-
-    /* primary diagonal check - inlined */
-    match = 1;
-    for (i = 0; i < BOARD_SIZE && match; i++)
-        match = match && (g[i][i] == CELL_X);
-    if (match) return SCORE_X;
-    
-    match = 1;
-    for (i = 0; i < BOARD_SIZE && match; i++)
-        match = match && (g[i][i] == CELL_O);
-    if (match) return SCORE_O;
-
-    /* secondary diagonal check - inlined */
-    match = 1;
-    for (i = 0; i < BOARD_SIZE && match; i++)
-        match = match && (g[i][BOARD_SIZE-1-i] == CELL_X);
-    if (match) return SCORE_X;
-    
-    match = 1;
-    for (i = 0; i < BOARD_SIZE && match; i++)
-        match = match && (g[i][BOARD_SIZE-1-i] == CELL_O);
-    if (match) return SCORE_O;
-
-    return SCORE_TIE;
 }
 
-int mini(int a, int b) {
-    return a < b ? a : b;
-}
+/* remember a move that cut a node off, deeper cutoffs earn more credit */
+void note_cutoff(engine_ctx * ctx, int depth, bool ismax, int sq) {
+    int * killers = ctx->killers[depth];
+    int * history = ctx->history[ismax];
+    int remain = ctx->search_depth - depth;
 
-int maxi(int a, int b) {
-    return a > b ? a : b;
+    if (killers[0] != sq) {
+        killers[1] = killers[0];
+        killers[0] = sq;
+    }
+    if ((history[sq] += remain * remain) > HISTORY_MAX)
+        for (int i = 0; i < CELL_COUNT; i++) history[i] >>= 1;
 }
 
-#ifdef _USE_ALPHA_BETA_PRUNE_
-/* the minimax algorithm: assuming player is on the minimizer side */
-int minimax(game_board g, int depth, bool ismax, int alpha, int beta) {
-    int r, c, best, score;
+/* the minimax algorithm: assuming player is on the minimizer side,
+   scores are the computer's whether it plays X or O */
+int minimax(engine_ctx * ctx, int depth, bool ismax, int alpha, int beta) {
+    game_board * g = &ctx->board;
+    int moves[CELL_COUNT];
+    int n, sq, best, score, hint, sym, best_sq = -1;
+    int old_alpha, old_beta;
     
-    /* Check transposition table */
-    unsigned int hash = hash_board(g);
-    int cached = lookup_trans_table(hash, game_depth - depth);
-    if (cached != MIN_INF - 1) return cached;
+    if (!ctx->prune) {                      /* plain minimax: no window, no cutoff */
+        alpha = MIN_INF;
+        beta = MAX_INF;
+    }
+    old_alpha = alpha;
+    old_beta = beta;
     
-    score = evaluate(g);                    /* evaluating the board */
-    if (score != SCORE_TIE) return score;   /* return score if a player won */
+    /* Check transposition table under the key shared by all symmetric
+       positions, the table keeps moves as seen on that canonical board */
+    uint64_t key = canonical_key(g, &sym);
+    if (ismax) key ^= zobrist_side;
+    ctx->tt_probes++;
+    if (lookup_trans_table(ctx->tt, key, ctx->search_depth - depth, depth + 1,
+                           alpha, beta, &score, &hint)) {
+        ctx->tt_hits++;
+        return score;
+    }
+    if (hint >= 0) hint = sym_back[sym][hint];
+    
+    /* wins were caught when the last move was made */
     if (!has_move(g)) return SCORE_TIE;     /* no more move? it is a tie */
 
-    if (depth >= game_depth) return score;
-
-    progress_show();                        /* show progress bar */
-
-    states++;                               /* explored a search state */
+    if (depth >= ctx->search_depth) {       /* horizon: a guess */
+        STAT_LEAF(ctx, depth + 1);
+        return score_for(ctx->computer, g->heuristic);
+    }
+    if (ctx->stop && atomic_get(ctx->stop)) return SCORE_TIE;   /* helper not needed */
+
+    ctx->states++;                          /* explored a search state */
+    STAT_NODE(ctx, depth + 1);
+    atomic_put(&ctx->live.nodes, ctx->states);  /* for the renderer */
+    if (ctx->deadline && (ctx->states & 1023) == 0 && clock_ms() >= ctx->deadline)
+        atomic_put(ctx->stop, 1);           /* out of time */
+    n = gen_moves(g, moves);                /* empty cells, best first */
+    order_moves(ctx, moves, n, hint, depth, ismax); /* likely cutoffs first */
     
     if (ismax) {                            /* evaluating the maximizer player */
         best = MIN_INF;                     /* for finding max */
         
-        /* Move ordering: try priority moves first */
-        for (int i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
-            int pos = move_priority[i];
-            r = pos / BOARD_SIZE;
-            c = pos % BOARD_SIZE;
+        for (int i = 0; i < n; i++) {
+            sq = moves[i];
+            place(g, sq, ctx->computer);    /* assuming computer move on that cell */
+            ctx->move_count++;
+            /* a completed line ends the game, else explore further down */
+            score = wins_at(g, sq, ctx->computer) ? mate_score(depth + 2)
+                  : search_child(ctx, depth+1, false, alpha, beta, i == 0);
+            unplace(g, sq, ctx->computer);  /* undo that move */
+            ctx->move_count--;
+            if (score > best) {             /* obtain the maximum score */
+                best = score;
+                best_sq = sq;
+            }
             
-            if (g[r][c] == CELL_E) {        /* found an empty cell */
-                g[r][c] = computer;         /* assuming computer move on that cell */
-                move_count++;
-                /* recursively explore down the state space */
-                score = minimax(g, depth+1, false, alpha, beta);
-                g[r][c] = CELL_E;           /* undo that move */
-                move_count--;
-                best = maxi(score, best);   /* obtain the maximum score */
-                
-                /* alpha-beta pruning */
-                alpha = maxi(alpha, best);
-                if (beta <= alpha) break;   /* cutoff */
+            /* alpha-beta pruning */
+            alpha = maxi(alpha, best);
+            if (beta <= alpha) {            /* cutoff */
+                STAT_CUT(ctx, depth + 1, i);
+                note_cutoff(ctx, depth, true, sq);
+                break;
             }
         }
         
-        /* Store in transposition table */
-        store_trans_table(hash, best, game_depth - depth);
+        /* Store in transposition table, unless the search was cut short */
+        if (ctx->stop && atomic_get(ctx->stop)) return best;
+        STAT_STORE(ctx, store_trans_table(ctx->tt, key, best, ctx->search_depth - depth,
+                   depth + 1, score_bound(best, old_alpha, old_beta), sym_cell[sym][best_sq]));
         return best;
     }
     else {                                  /* the minimizer's turn */
         best = MAX_INF;                     /* for finding min */
         
-        /* Move ordering: try priority moves first */
-        for (int i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
-            int pos = move_priority[i];
-            r = pos / BOARD_SIZE;
-            c = pos % BOARD_SIZE;
+        for (int i = 0; i < n; i++) {
+            sq = moves[i];
+            place(g, sq, ctx->human);       /* assuming human move on that cell */
+            ctx->move_count++;
+            /* a completed line ends the game, else explore further down */
+            score = wins_at(g, sq, ctx->human) ? -mate_score(depth + 2)
+                  : search_child(ctx, depth+1, true, alpha, beta, i == 0);
+            unplace(g, sq, ctx->human);     /* undo that move */
+            ctx->move_count--;
+            if (score < best) {             /* obtain the minimum score */
+                best = score;
+                best_sq = sq;
+            }
             
-            if (g[r][c] == CELL_E) {        /* found an empty cell */
-                g[r][c] = human;            /* assuming human move on that cell */
-                move_count++;
-                /* recursively explore down the state space */
-		        score = minimax(g, depth+1, true, alpha, beta);
-                g[r][c] = CELL_E;           /* undo that move */
-                move_count--;
-                best = mini(score, best);   /* obtain the minimum score */
-                
-                /* alpha-beta pruning */
-                beta = mini(beta, best);
-                if (beta <= alpha) break;   /* cutoff */
+            /* alpha-beta pruning */
+            beta = mini(beta, best);
+            if (depth == 0 && ctx->split && ctx->prune) /* adopt a bound found by another worker */
+                old_alpha = alpha = maxi(alpha, split_alpha(ctx->split, ctx->split_index));
+            if (beta <= alpha) {            /* cutoff */
+                STAT_CUT(ctx, depth + 1, i);
+                note_cutoff(ctx, depth, false, sq);
+                break;
             }
         }
         
-        /* Store in transposition table */
-        store_trans_table(hash, best, game_depth - depth);
+        /* Store in transposition table, unless the search was cut short */
+        if (ctx->stop && atomic_get(ctx->stop)) return best;
+        STAT_STORE(ctx, store_trans_table(ctx->tt, key, best, ctx->search_depth - depth,
+                   depth + 1, score_bound(best, old_alpha, old_beta), sym_cell[sym][best_sq]));
         return best;
     }
 }
-#else
-/* the minimax algorithm: assuming player is on the minimizer side */
-int minimax(game_board g, int depth, bool ismax) {
-    int r, c, best, score;
-    
-    /* Check transposition table */
-    unsigned int hash = hash_board(g);
-    int cached = lookup_trans_table(hash, game_depth - depth);
-    if (cached != MIN_INF - 1) return cached;
-    
-    score = evaluate(g);                    /* evaluating the board */
-    if (score != SCORE_TIE) return score;   /* return score if a player won */
-    if (!has_move(g)) return SCORE_TIE;     /* no more move? it is a tie */
 
-    if (depth >= game_depth) return score;
-
-    progress_show();                        /* show progress bar */
+/* human make his move */
+bool human_move(engine_ctx * ctx, int c, int r) {
+    game_board * g = &ctx->board;
+    if (is_playable(g, c, r)) {         /* check if the cell is empty */
+        place(g, r * BOARD_SIZE + c, ctx->human);   /* set the piece */
+        ctx->move_count++;              /* increment move counter */
+        ctx->current = ctx->computer;   /* and switch turn to computer */
+        return true;                    /* human made a move */
+    }
+    return false;                       /* human could not make a move */
+}
 
-    states++;                               /* explored a search state */
-    
-    if (ismax) {                            /* evaluating the maximizer player */
-        best = MIN_INF;                     /* for finding max */
+/* search the root moves one after another, returns the best one.
+ * A 'score' outside (alpha, beta) is only a bound and its move no answer.
+ */
+int serial_root(engine_ctx * ctx, int * moves, int n, int alpha, int beta, int * score) {
+    game_board * g = &ctx->board;
+    int best = MIN_INF;                 /* for finding the best move */
+    int s, sq = -1;
+
+    STAT_NODE(ctx, 0);                  /* the root */
+    /* Normal mode: use minimax algorithm with move ordering */
+    for (int i = 0; i < n; i++) {
+        place(g, moves[i], ctx->computer);  /* assuming the move */
+        ctx->move_count++;
+        /* search the search space */
+        if (wins_at(g, moves[i], ctx->computer))
+            s = mate_score(1);
+        else
+            s = search_child(ctx, 0, false, maxi(alpha, best), beta, i == 0);
+        unplace(g, moves[i], ctx->computer);    /* and undo it */
+        ctx->move_count--;
         
-        /* Move ordering: try priority moves first */
-        for (int i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
-            int pos = move_priority[i];
-            r = pos / BOARD_SIZE;
-            c = pos % BOARD_SIZE;
+        if (s > best) {                 /* find the best score */
+            best = s;                   /* and save it */
+            sq = moves[i];              /* also the cell of that move */
+            atomic_put(&ctx->live.best, sq);
             
-            if (g[r][c] == CELL_E) {        /* found an empty cell */
-                g[r][c] = computer;         /* assuming computer move on that cell */
-                move_count++;
-                /* recursively explore down the state space */
-                score = minimax(g, depth+1, false);
-                g[r][c] = CELL_E;           /* undo that move */
-                move_count--;
-                best = maxi(score, best);   /* obtain the maximum score */
-            }
+            /* Early termination: if winning move found, take it */
+            if (best >= SCORE_WIN - 1 || best >= beta) break;
         }
-        
-        /* Store in transposition table */
-        store_trans_table(hash, best, game_depth - depth);
-        return best;
+        if (ctx->stop && atomic_get(ctx->stop)) break;
     }
-    else {                                  /* the minimizer's turn */
-        best = MAX_INF;                     /* for finding min */
-        
-        /* Move ordering: try priority moves first */
-        for (int i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
-            int pos = move_priority[i];
-            r = pos / BOARD_SIZE;
-            c = pos % BOARD_SIZE;
-            
-            if (g[r][c] == CELL_E) {        /* found an empty cell */
-                g[r][c] = human;            /* assuming human move on that cell */
-                move_count++;
-                /* recursively explore down the state space */
-		        score = minimax(g, depth+1, true);
-                g[r][c] = CELL_E;           /* undo that move */
-                move_count--;
-                best = mini(score, best);   /* obtain the minimum score */
-            }
+    *score = best;
+    return sq;
+}
+
+/* ---------------------- */
+/* Parallel root search: workers take root moves from a shared counter */
+
+/* lower bound a root move must beat, ties go to the earlier root move */
+int split_alpha(root_split * rs, int index) {
+    uint64_t best = atomic_get(&rs->best);
+    if (best == 0) return rs->alpha;    /* nothing found yet */
+    return SPLIT_INDEX(best) < index ? SPLIT_SCORE(best) : SPLIT_SCORE(best) - 1;
+}
+
+/* publish a root result if it beats the shared best */
+void split_update(root_split * rs, int score, int index) {
+    uint64_t mine = SPLIT_PACK(score, index);
+    uint64_t seen = atomic_get(&rs->best);
+    while (mine > seen)
+        if (atomic_cas(&rs->best, &seen, mine)) {
+            atomic_put(&rs->ctx->live.best, rs->moves[index]);
+            break;
         }
-        
-        /* Store in transposition table */
-        store_trans_table(hash, best, game_depth - depth);
-        return best;
+}
+
+void * split_worker(void * arg) {
+    engine_ctx * w = (engine_ctx *)arg;
+    root_split * rs = w->split;
+    game_board * g = &w->board;
+    int i, sq, alpha, score;
+
+    while ((i = atomic_add(&rs->next, 1)) < rs->n) {
+        if (w->stop && atomic_get(w->stop)) break;
+        sq = rs->moves[i];
+        alpha = split_alpha(rs, i);
+        if (alpha >= SCORE_WIN - 1 || alpha >= rs->beta) continue;    /* an earlier move settled it */
+
+        w->split_index = i;
+        place(g, sq, w->computer);
+        w->move_count++;
+        if (wins_at(g, sq, w->computer))
+            score = mate_score(1);
+        else
+            score = search_child(w, 0, false, alpha, rs->beta, alpha == rs->alpha);
+        unplace(g, sq, w->computer);
+        w->move_count--;
+        if (score > alpha) split_update(rs, score, i);
     }
+    return NULL;
 }
-#endif
 
-/* human make his move */
-bool human_move(game_board g, int c, int r) {
-    if (is_playable(g, c, r)) {        /* check if the cell is empty */
-        g[r][c] = human;            /* set the piece */
-        move_count++;               /* increment move counter */
-        current = computer;             /* and switch turn to computer */
-        return true;                    /* human made a move */
+/* search the root moves on all threads, returns the chosen move */
+int split_root(engine_ctx * ctx, int * moves, int n, int alpha, int beta, int * score) {
+    root_split rs;
+    thread_t tid[MAX_THREADS];
+    int i, workers = mini(ctx->threads, n);
+
+    memcpy(rs.moves, moves, n * sizeof(int));
+    rs.ctx = ctx;
+    rs.n = n;
+    rs.next = 0;
+    rs.alpha = alpha;
+    rs.beta = beta;
+    rs.best = 0;
+
+    for (i = 1; i < workers; i++) {
+        engine_ctx * h = &ctx->helpers[i-1];
+        engine_sync(h, ctx);
+        h->split = &rs;
+        h->stop = ctx->stop;            /* any worker may run out of time */
+        if (!thread_start(&tid[i], split_worker, h)) break;
     }
-    return false;                       /* human could not make a move */
+    workers = i;
+    ctx->split = &rs;
+    split_worker(ctx);                  /* this thread is worker 0 */
+    ctx->split = NULL;
+
+    for (i = 1; i < workers; i++) {
+        thread_join(tid[i]);
+        ctx->states += ctx->helpers[i-1].states;
+        ctx->tt_probes += ctx->helpers[i-1].tt_probes;
+        ctx->tt_hits += ctx->helpers[i-1].tt_hits;
+        STAT_MERGE(ctx, &ctx->helpers[i-1]);
+        ctx->helpers[i-1].split = NULL;
+        ctx->helpers[i-1].stop = NULL;
+    }
+    if (rs.best == 0) {                 /* failed low, or stopped before any result */
+        *score = alpha;
+        return moves[0];
+    }
+    *score = SPLIT_SCORE(rs.best);
+    return moves[SPLIT_INDEX(rs.best)];
 }
 
-/* AI select its best move */
-void computer_move(game_board g) {
-    int best = -1000;			        /* for finding the best move */
-    int score, r, c;
-    move mv = {-1, -1};
+/* Lazy SMP: every helper searches the whole tree in its own move order
+ * and shares what it learns through the table, the main thread's own
+ * search decides the move and stops the helpers when it is done
+ */
+typedef struct {                        /* a helper and its root move order */
+    engine_ctx * ctx;
+    int moves[CELL_COUNT];
+    int n;
+} lazy_job;
+
+void * lazy_worker(void * arg) {
+    lazy_job * job = (lazy_job *)arg;
+    int score;
+    serial_root(job->ctx, job->moves, job->n, MIN_INF, MAX_INF, &score);
+    return NULL;
+}
+
+int lazy_root(engine_ctx * ctx, int * moves, int n, int alpha, int beta, int * score) {
+    lazy_job jobs[MAX_THREADS];
+    thread_t tid[MAX_THREADS];
+    int i, j, sq, stop = 0;
+
+    for (i = 1; i < ctx->threads; i++) {
+        lazy_job * job = &jobs[i];
+        job->ctx = &ctx->helpers[i-1];
+        job->n = n;
+        for (j = 0; j < n; j++)         /* each helper starts somewhere else */
+            job->moves[j] = moves[(i + j) % n];
+        engine_sync(job->ctx, ctx);
+        job->ctx->stop = &stop;
+        if (!thread_start(&tid[i], lazy_worker, job)) break;
+    }
+    sq = serial_root(ctx, moves, n, alpha, beta, score);    /* the move comes from here */
+    atomic_put(&stop, 1);
+
+    for (j = 1; j < i; j++) {
+        thread_join(tid[j]);
+        ctx->states += ctx->helpers[j-1].states;
+        ctx->tt_probes += ctx->helpers[j-1].tt_probes;
+        ctx->tt_hits += ctx->helpers[j-1].tt_hits;
+        STAT_MERGE(ctx, &ctx->helpers[j-1]);
+        ctx->helpers[j-1].stop = NULL;
+    }
+    return sq;
+}
+/* ---------------------- */
+
+/* search the root moves once to the current ply limit */
+int search_root(engine_ctx * ctx, int * moves, int n, int alpha, int beta, int * score) {
+    if (ctx->threads > 1 && ctx->smp == SMP_SPLIT)  /* root moves spread over threads */
+        return split_root(ctx, moves, n, alpha, beta, score);
+    if (ctx->threads > 1 && ctx->smp == SMP_LAZY)   /* helpers warm up the shared table */
+        return lazy_root(ctx, moves, n, alpha, beta, score);
+    return serial_root(ctx, moves, n, alpha, beta, score);
+}
+
+/* iterative deepening: one ply deeper each time until the budget runs out,
+ * the move and 'score' of the deepest finished iteration are the answer
+ */
+int deepen_root(engine_ctx * ctx, int * moves, int n, int * result) {
+    int empty = bit_count(empty_cells(&ctx->board));
+    int limit = mini(ctx->game_depth, empty - 1);   /* deeper than the board is pointless */
+    int depth, sq, score = SCORE_TIE, best = moves[0];
+    int alpha, beta;
+
+    if (!ctx->deadline)                 /* unless a clock runs for the whole move */
+        ctx->deadline = clock_ms() + ctx->time_budget;
+    ctx->stop = &ctx->halt;             /* the clock or engine_stop() raise it */
+    for (depth = 1; depth <= limit; depth++) {
+        ctx->search_depth = depth;
+        atomic_put(&ctx->live.depth, depth);
+        alpha = MIN_INF;
+        beta = MAX_INF;
+        if (ctx->pvs && ctx->prune && depth > 1) {  /* expect about the last score */
+            alpha = score - ASPIRATION;
+            beta = score + ASPIRATION;
+        }
+        sq = search_root(ctx, moves, n, alpha, beta, &score);
+        if ((score <= alpha || score >= beta) && !atomic_get(ctx->stop))
+            sq = search_root(ctx, moves, n, MIN_INF, MAX_INF, &score);  /* missed */
+        if (atomic_get(ctx->stop)) break;   /* unfinished, it does not count */
+        STAT_ITERATION(ctx, depth);
+        best = sq;
+        *result = score;
+        move_to_front(moves, n, best);  /* principal variation goes first */
+        if (score_decided(score)) break;    /* a sure result, the fastest one */
+    }
+    ctx->stop = NULL;
+    ctx->deadline = 0;
+    return best;
+}
 
-    states = 0;                         /* reset state counter */
+/* the move of the computer, X or O, and its score as the computer sees
+ * it, SCORE_UNKNOWN when the move was not scored; -1 on a full board
+ */
+int select_move(engine_ctx * ctx, int * score) {
+    game_board * g = &ctx->board;
+    int moves[CELL_COUNT];
+    int n, sq = -1;
+
+    ctx->states = 0;                    /* reset state counter */
+    ctx->tt_probes = ctx->tt_hits = 0;
+    STAT_RESET(ctx);
+    atomic_put(&ctx->live.nodes, 0);
+    atomic_put(&ctx->live.depth, ctx->search_depth = ctx->game_depth);
+    atomic_put(&ctx->live.best, -1);
+    tt_new_search(ctx->tt);             /* age older table entries */
+    order_reset(ctx);
+    *score = SCORE_UNKNOWN;
+    n = gen_moves(g, moves);            /* empty cells, best first */
+    if (n == 0) return -1;              /* board is full */
     
     /* Easy mode: make random moves */
-    if (game_depth == GAME_EASY) {
-        int empty_cells[BOARD_SIZE * BOARD_SIZE][2];
-        int count = 0;
-        
-        /* find all empty cells */
-        for (r = 0; r < BOARD_SIZE; r++)
-        for (c = 0; c < BOARD_SIZE; c++)
-            if (g[r][c] == CELL_E) {
-                empty_cells[count][0] = r;
-                empty_cells[count][1] = c;
-                count++;
-            }
-        
-        /* pick a random empty cell */
-        if (count > 0) {
-            int random_index = rand() % count;
-            mv.r = empty_cells[random_index][0];
-            mv.c = empty_cells[random_index][1];
-        }
+    if (ctx->game_depth == GAME_EASY) {
+        sq = moves[mcts_random(&ctx->rng) % n];     /* pick a random empty cell */
+    }
+    else if (ctx->book && ctx->game_depth >= GAME_IMPOSSIBLE
+          && (sq = book_probe(g, ctx->computer, score)) >= 0) {
+        atomic_put(&ctx->live.best, sq);    /* solved already, no search */
+        *score = score_for(ctx->computer, *score);
+    }
+    else if (ctx->book && ctx->game_depth >= GAME_IMPOSSIBLE
+          && (sq = db_probe(ctx->db, g, ctx->computer, score)) >= 0) {
+        atomic_put(&ctx->live.best, sq);    /* looked up in the database */
+        *score = score_for(ctx->computer, *score);
+    }
+#if K_IN_A_ROW
+    else if ((sq = vcf_move(g, ctx->computer)) >= 0) {
+        atomic_put(&ctx->live.best, sq);    /* a forced win by threats */
+        *score = mate_score(CELL_COUNT);    /* of unknown length */
     }
-    else {
-        /* Normal mode: use minimax algorithm with move ordering */
-        for (int i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
-            int pos = move_priority[i];
-            r = pos / BOARD_SIZE;
-            c = pos % BOARD_SIZE;
-            
-            if (g[r][c] == CELL_E) {        /* found an empty cell */
-                g[r][c] = computer;         /* assuming the move */
-                move_count++;
-                /* search the search space */
-#ifdef _USE_ALPHA_BETA_PRUNE_
-                score = minimax(g, 0, false, MIN_INF, MAX_INF);
-#else
-                score = minimax(g, 0, false);
 #endif
-                g[r][c] = CELL_E;           /* and undo it */
-                move_count--;
-                
-                if (score > best) {         /* find the best score */             
-                    best = score;           /* and save it */
-                    mv.r = r;               /* also the coordinates */
-                    mv.c = c;               /* of that move */
-                    
-                    /* Early termination: if winning move found, take it */
-                    if (best == SCORE_X) break;
-                }
-            }
-        }
+    else if ((n = unique_moves(g, moves, n)) == 1) {
+        sq = moves[0];                  /* nothing to think about */
     }
-    
-    g[mv.r][mv.c] = computer;           /* computer make a move */
-    move_count++;                       /* increment move counter */
-    current = human;                    /* turn is now back to human */
+    else {
+        ctx->stop = &ctx->halt;         /* engine_stop() ends it early */
+        sq = ctx->search->search(ctx, moves, n, score);
+        ctx->stop = NULL;
+        atomic_put(&ctx->halt, 0);      /* spent: a stop from now on is for the next one */
+    }
+    return sq;
+}
+
+/* AI select its best move */
+void computer_move(engine_ctx * ctx) {
+    int score, sq = select_move(ctx, &score);
+
+    if (sq < 0) return;                 /* board is full */
+    place(&ctx->board, sq, ctx->computer);  /* computer make a move */
+    ctx->move_count++;                  /* increment move counter */
+    ctx->current = ctx->human;          /* turn is now back to human */
+    STAT_DONE(ctx);                     /* dumped if a file is set */
+}
+
+/* ---------------------- */
+/* Search engines: the move pickers select_move() calls once the book,
+ * the database and the forced moves had nothing to say. Each is a table
+ * of functions, registered by name, so a context can change engines
+ * between games or between moves with engine_use().
+ */
+
+/* plain minimax: no window, every node searched */
+bool init_minimax(engine_ctx * ctx) {
+    ctx->prune = false;
+    ctx->pvs = false;
+    return true;
+}
+
+/* alpha-beta with the table, killers and history ordering the moves */
+bool init_alphabeta(engine_ctx * ctx) {
+    ctx->prune = true;
+    ctx->pvs = false;
+    return true;
+}
+
+/* alpha-beta with null windows off the first move and aspiration */
+bool init_pvs(engine_ctx * ctx) {
+    ctx->prune = true;
+    ctx->pvs = true;
+    return true;
+}
+
+/* the minimax family, as deep as the clock allows or to the fixed depth */
+int minimax_move(engine_ctx * ctx, int * moves, int n, int * score) {
+    if (ctx->time_budget > 0)
+        return deepen_root(ctx, moves, n, score);
+    return search_root(ctx, moves, n, MIN_INF, MAX_INF, score);
+}
+
+/* playouts from the tree kept since the last move, minimax if there is none */
+int playout_move(engine_ctx * ctx, int * moves, int n, int * score) {
+    int sq = mcts_move(ctx);
+    return sq >= 0 ? sq : minimax_move(ctx, moves, n, score);
+}
+
+/* a proven win, else minimax with the time the proof left */
+int proof_move(engine_ctx * ctx, int * moves, int n, int * score) {
+    int sq;
+
+    if (ctx->time_budget > 0)           /* one clock for both */
+        ctx->deadline = clock_ms() + ctx->time_budget;
+    if ((sq = pns_move(ctx)) < 0)
+        sq = minimax_move(ctx, moves, n, score);
+    ctx->deadline = 0;
+    return sq;
+}
+
+/* raise the flag every engine polls, from any thread */
+void halt_search(engine_ctx * ctx) {
+    atomic_put(&ctx->halt, 1);
+}
+
+void report_search(engine_ctx * ctx, search_report * r) {
+    r->nodes = ctx->states;
+    r->depth = ctx->search_depth;
+    r->tt_probes = ctx->tt_probes;
+    r->tt_hits = ctx->tt_hits;
 }
 
-#endif
\ No newline at end of file
+/* playouts have no plies and no table */
+void report_playouts(engine_ctx * ctx, search_report * r) {
+    memset(r, 0, sizeof(search_report));
+    r->nodes = ctx->states;
+}
+
+void free_none(engine_ctx * ctx) {
+    (void)ctx;
+}
+
+/* the kept Monte Carlo trees of a context and its helpers */
+void free_trees(engine_ctx * ctx) {
+    for (int i = 0; i < ctx->threads; i++) {
+        engine_ctx * owner = i ? &ctx->helpers[i - 1] : ctx;
+        if (owner->mcts) mcts_free(owner->mcts);
+        free(owner->mcts);
+        owner->mcts = NULL;
+    }
+}
+
+const search_engine engine_minimax = {
+    "MINIMAX", "plain minimax, every node searched",
+    init_minimax, minimax_move, halt_search, report_search, free_none
+};
+
+const search_engine engine_alphabeta = {
+    "ABPRUNE", "alpha-beta pruning with move ordering",
+    init_alphabeta, minimax_move, halt_search, report_search, free_none
+};
+
+const search_engine engine_pvs = {
+    "PVS", "principal variation search with aspiration windows",
+    init_pvs, minimax_move, halt_search, report_search, free_none
+};
+
+const search_engine engine_mcts = {
+    "MCTS", "Monte Carlo tree search kept between moves, PVS if it cannot run",
+    init_pvs, playout_move, halt_search, report_playouts, free_trees
+};
+
+const search_engine engine_pns = {
+    "PN2", "proof-number search for forced wins, PVS if none is proven",
+    init_pvs, proof_move, halt_search, report_search, free_none
+};
+
+const search_engine * engine_list[ENGINE_MAX] = {
+    &engine_minimax, &engine_alphabeta, &engine_pvs, &engine_mcts, &engine_pns
+};
+int engine_total = 5;
+
+/* add an engine to the list, false if it is full or the name is taken */
+bool engine_register(const search_engine * e) {
+    if (engine_total == ENGINE_MAX || engine_find(e->name)) return false;
+    engine_list[engine_total++] = e;
+    return true;
+}
+
+/* an engine by name, any case; NULL if none */
+const search_engine * engine_find(const char * name) {
+    for (int i = 0; i < engine_total; i++) {
+        const char * a = engine_list[i]->name, * b = name;
+        while (*a && toupper((unsigned char)*a) == toupper((unsigned char)*b)) a++, b++;
+        if (!*a && !*b) return engine_list[i];
+    }
+    return NULL;
+}
+
+int engine_count() {
+    return engine_total;
+}
+
+const search_engine * engine_at(int i) {
+    return i >= 0 && i < engine_total ? engine_list[i] : NULL;
+}
+
+/* switch the engine of a context, between games or moves; the old one
+ * is kept if the new one cannot run
+ */
+bool engine_use(engine_ctx * ctx, const search_engine * e) {
+    if (!e) return false;
+    if (e == ctx->search) return true;  /* keep what it learnt */
+    if (!e->init(ctx)) return false;
+    ctx->search->free(ctx);
+    ctx->search = e;
+    return true;
+}
+
+/* end the running search of a context early, it still answers a move;
+ * sent between searches it ends the next one as soon as it starts
+ */
+void engine_stop(engine_ctx * ctx) {
+    ctx->search->stop(ctx);
+}
+
+/* figures of the last move of a context */
+void engine_report(engine_ctx * ctx, search_report * r) {
+    ctx->search->stats(ctx, r);
+}
+
+#endif
@@ -2,7 +2,7 @@
  * GAME.H: Tic-Tac-Toe AI Game Engine
  * -------
  * Coded by Trinh D.D. Nguyen
- * Last updates: Nov, 2025
+ * Last updates: Oct, 2026
  */
 #ifndef _TICTACTOE_MINIMAX_GAME_H_
 #define _TICTACTOE_MINIMAX_GAME_H_
@@ -36,7 +36,7 @@ void  game_logo() {
     clear();
     puts(logo);
     printf( "%32s"C_ERROR"%d"C_RESET"."C_ERROR"%d"C_RESET" ["C_MISC"%s"C_RESET"]\n",            
-            "V", GAME_VERSION & 0x00FF, (GAME_VERSION >> 8), GAME_ENGINE);
+            "V", GAME_VERSION & 0x00FF, (GAME_VERSION >> 8), engine_name(&engine));
 }
 
 bool game_init() {
@@ -49,7 +49,7 @@ bool game_init() {
 #endif
 
     /* seed random number generator for easy mode */
-    srand((unsigned int)time(NULL));
+    engine.rng = (uint64_t)time(NULL) | 1;
 
     char choice;
     int valid = 0;
@@ -62,10 +62,13 @@ bool game_init() {
                 "  "C_MEDIUM"M"C_RESET"edium\n"
                 "  "C_HARD"H"C_RESET"ard\n"
                 "  "C_IMPOSSIBLE"I"C_RESET"mpossible\n"
+                "  "C_IMPOSSIBLE"T"C_RESET"imed, %d ms a move\n"
+                "  Monte "C_IMPOSSIBLE"C"C_RESET"arlo, %d ms a move\n"
+                "  "C_IMPOSSIBLE"P"C_RESET"roof search, then Impossible\n"
                 C_DARK"  -------------"C_RESET"\n"
                 "  Nah, I "C_O"q"C_RESET"uit\n"
                 C_DARK"  -------------"C_RESET"\n"
-                "Your choice: ");
+                "Your choice: ", GAME_TIME_MS, GAME_TIME_MS);
         
         if (scanf(" %c", &choice) != 1) {
             printf(C_ERROR"Invalid input! Please try again.\n"C_RESET);
@@ -79,31 +82,49 @@ bool game_init() {
         while ((c = getchar()) != '\n' && c != EOF);
         
         choice = toupper(choice);
+        engine.time_budget = 0;         /* fixed depth unless timed */
+        engine.book = true;             /* solved positions unless the level searches */
+        engine_use(&engine, engine_find("PVS"));
         switch (choice) {
         case 'E': 
-            game_depth = GAME_EASY; 
-            progress_interval(2); 
+            engine.game_depth = GAME_EASY; 
             valid = 1;
             break;
         case 'M': 
-            game_depth = GAME_MEDIUM; 
-            progress_interval(5); 
+            engine.game_depth = GAME_MEDIUM; 
             valid = 1;
             break;
         case 'H': 
-            game_depth = GAME_HARD; 
-            progress_interval(50); 
+            engine.game_depth = GAME_HARD; 
             valid = 1;
             break;
         case 'I': 
-            game_depth = GAME_IMPOSSIBLE; 
-            progress_interval(100); 
+            engine.game_depth = GAME_IMPOSSIBLE; 
+            valid = 1;
+            break;
+        case 'T':
+            engine.game_depth = CELL_COUNT; /* no depth cap, only the clock */
+            engine.time_budget = GAME_TIME_MS;
+            engine.book = false;        /* the search is the point of the level */
+            valid = 1;
+            break;
+        case 'C':
+            engine.game_depth = CELL_COUNT;
+            engine.time_budget = GAME_TIME_MS;
+            engine.book = false;
+            engine_use(&engine, engine_find("MCTS"));   /* playouts instead of minimax */
+            valid = 1;
+            break;
+        case 'P':
+            engine.game_depth = GAME_IMPOSSIBLE;
+            engine.book = false;
+            engine_use(&engine, engine_find("PN2"));    /* forced wins proven, else minimax */
             valid = 1;
             break;
         case 'Q': 
             return false;
         default:
-            printf(C_ERROR"Invalid choice! Please select E, M, H, I, or Q.\n"C_RESET);
+            printf(C_ERROR"Invalid choice! Please select E, M, H, I, T, C, P, or Q.\n"C_RESET);
             mssleep(1000);
             valid = 0;
         }
@@ -115,24 +136,27 @@ bool game_init() {
 int game_play() {
     bool quit = false;                  /* quit flag */
     bool valid;
-    int input, c, r, eval, range;
+    int input, c, r, eval, range, proof;
     int scan_result, ch;
+    game_board * board = &engine.board;
     
-    current = human;                    /* human moves first */
+    engine.current = engine.human;      /* human moves first */
     range = (BOARD_SIZE * BOARD_SIZE)-1;
-    init_board(board);
+    new_game(&engine);
     do {
         game_logo();
         show_board(board, false);       /* draw game board */
         if (has_move(board)) {          /* if the board is playable */
             do {                        /* get user input as index */
-                printf("Moves explored: ["C_THINKING"%-6d"C_RESET"]\n", states);
+                printf("Moves explored: ["C_THINKING"%-6d"C_RESET"] "C_DARK"%s"C_RESET"\n",
+                       engine.states, engine_name(&engine));
                 printf(C_BRIGHT"Human "C_RESET"["C_O"%c"C_RESET"] - "
-                       C_BRIGHT"Computer "C_RESET"["C_X"%c"C_RESET"]\n", human, computer);
+                       C_BRIGHT"Computer "C_RESET"["C_X"%c"C_RESET"]\n",
+                       engine.human, engine.computer);
                 valid = false;
                 
                 while (!valid) {
-                    printf(C_BRIGHT"Your move "C_DARK"["C_WARNING"%d"C_DARK"-"C_WARNING"%d"C_DARK"] ("C_ERROR"-1"C_BRIGHT" = "C_WARNING"quit"C_DARK"): ", 0, range);
+                    printf(C_BRIGHT"Your move "C_DARK"["C_WARNING"%d"C_DARK"-"C_WARNING"%d"C_DARK"] ("C_ERROR"-1"C_BRIGHT" = "C_WARNING"quit"C_DARK", "C_ERROR"-2"C_BRIGHT" = "C_WARNING"am I lost?"C_DARK"): ", 0, range);
                     
                     scan_result = scanf("%d", &input);
                     
@@ -148,7 +172,7 @@ int game_play() {
                     while ((ch = getchar()) != '\n' && ch != EOF);
                     
                     /* validate range */
-                    if (input < -1 || input > range) {
+                    if (input < -2 || input > range) {
                         printf(C_ERROR"Out of range [%d-%d]: "C_RESET, 0, range);
                         continue;
                     }
@@ -161,6 +185,21 @@ int game_play() {
                     break;
                 }
                 
+                if (input == -2) {      /* prove a forced win of the computer */
+                    progress_start(&engine.live);
+                    proof = pns_lost(&engine);
+                    progress_stop();
+                    if (proof == PNS_PROVEN)
+                        printf(C_ERROR"Lost: the computer wins whatever you play.\n"C_RESET);
+                    else if (proof == PNS_DISPROVEN && K_IN_A_ROW)
+                        printf(C_EASY"No forced win of the computer found.\n"C_RESET);
+                    else if (proof == PNS_DISPROVEN)
+                        printf(C_EASY"Not lost: the computer cannot force a win.\n"C_RESET);
+                    else
+                        printf(C_WARNING"Unknown within %d nodes.\n"C_RESET, engine.pns_nodes);
+                    continue;
+                }
+                
                 r = input / BOARD_SIZE; /* convert to row and col */
                 c = input % BOARD_SIZE; /* and make the move if possible */
                 
@@ -169,7 +208,7 @@ int game_play() {
                     printf(C_ERROR"Cell occupied! Try another.\n"C_RESET);
                     mssleep(800);
                 } else {
-                    human_move(board, c, r);
+                    human_move(&engine, c, r);
                     break;
                 }
             } while(true);
@@ -177,7 +216,9 @@ int game_play() {
         else quit = true;               /* no more cell to play */
 
         if (!quit) {                    /* if human placed a move */
-            computer_move(board);       /* now to the computer's turn */
+            progress_start(&engine.live);   /* draw while the AI thinks */
+            computer_move(&engine);     /* now to the computer's turn */
+            progress_stop();
             eval = evaluate(board);     /* evaluate the board */
             switch (eval) {
             case SCORE_X: quit = true; break;
@@ -190,7 +231,7 @@ int game_play() {
 
 void game_close(int result) {
     game_logo();
-    show_board(board, true);
+    show_board(&engine.board, true);
     switch (result) {
     case SCORE_X: printf(C_X"X"C_WARNING" WINS!"C_RESET"\n"); break;
     case SCORE_O: printf(C_O"O"C_WARNING" WINS!"C_RESET"\n"); break;
@@ -2,7 +2,7 @@
  * HELPERS.H: Tic-Tac-Toe AI helpers
  * ----------
  * Coded by Trinh D.D. Nguyen
- * Last updates: Nov, 2025
+ * Last updates: Oct, 2026
  */
 #ifndef _TICTACTOE_MINIMAX_HELPERS_H_
 #define _TICTACTOE_MINIMAX_HELPERS_H_
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <time.h>
 #include "defs.h"
+#include "thread.h"
 
 /* =============== PROTOTYPES ==================== */
 
@@ -18,13 +19,17 @@ void clear();
 
 void mssleep(long ms);
 
-void progress_interval(int interval);
-
 void progress_show();
 
+void progress_start(search_info * info);
+
+void progress_stop();
+
 /* =============================================== */
 
+#define PROGRESS_FPS    20              /* frames drawn per second */
 #define PROGRESS_TOTAL  12
+#define PROGRESS_WIDTH  24              /* columns taken by "Thinking: [...] " */
 char progress[PROGRESS_TOTAL][128] = {
     C_MEDIUM"["C_THINKING"o"C_DARK"----------"C_MEDIUM"]\r",
     C_MEDIUM"["C_THINKING"oo"C_DARK"---------"C_MEDIUM"]\r",
@@ -41,8 +46,10 @@ char progress[PROGRESS_TOTAL][128] = {
 };
 int progress_current = 0;
 int progress_dir = +1;
-int progress_pacifier = 0;
-int progress_update = 1;
+int progress_pacifier = 0;              /* frames drawn */
+int progress_running = 0;               /* renderer keeps drawing while set */
+search_info * progress_info = NULL;     /* search being watched */
+thread_t progress_thread;
 
 void clear() {
     puts("\x1b[2J\x1b[H");
@@ -63,25 +70,64 @@ void mssleep(long ms) {
 #endif
 }
 
-void progress_interval(int interval) {
-    progress_update = interval * BOARD_SIZE;
-}
-
+/* draw one frame of the pacifier bar with the live search figures */
 void progress_show() {
     progress_pacifier++;
-    if (progress_pacifier % progress_update == 0) {
-        fputs(C_X"Thinking"C_NORMAL": ", stdout);
-        fputs(progress[progress_current], stdout);
-        fflush(stdout);
-#ifdef _USE_ALPHA_BETA_PRUNE_
-        mssleep(5);
+    fputs(C_X"Thinking"C_NORMAL": ", stdout);
+    fputs(progress[progress_current], stdout);
+    if (progress_info) {
+        printf("\x1b[%dC"C_DARK"%ld states, depth %d",
+               PROGRESS_WIDTH, atomic_get(&progress_info->nodes),
+               atomic_get(&progress_info->depth));
+        if (atomic_get(&progress_info->best) >= 0)
+            printf(", best %d", atomic_get(&progress_info->best));
+        fputs(C_RESET"\r", stdout);
+    }
+    fflush(stdout);
+    progress_current+=progress_dir;
+    if (progress_current <= 0 || progress_current >= PROGRESS_TOTAL-1)
+        progress_dir *= -1;
+}
+
+#ifdef _USE_THREADS_
+/* renderer thread: redraws at a fixed frame rate until stopped */
+void * progress_render(void * arg) {
+    (void)arg;
+    while (atomic_get(&progress_running)) {
+        /* sleep one frame in short slices so stopping stays snappy */
+        for (int t = 0; t < 1000 / PROGRESS_FPS && atomic_get(&progress_running); t += 10)
+            mssleep(10);
+        if (atomic_get(&progress_running)) progress_show();
+    }
+    return NULL;
+}
+#endif
+
+/* start drawing the bar while a search runs in the calling thread */
+void progress_start(search_info * info) {
+    progress_info = info;
+    atomic_put(&progress_running, 1);
+#ifdef _USE_THREADS_
+    if (!thread_start(&progress_thread, progress_render, NULL))
+        atomic_put(&progress_running, 0);
 #else
-        mssleep(1);
+    progress_show();                    /* no renderer: one static frame */
 #endif
-        progress_current+=progress_dir;
-        if (progress_current <= 0 || progress_current >= PROGRESS_TOTAL-1)
-            progress_dir *= -1;
+}
+
+/* stop the renderer, forget the search and wipe the bar */
+void progress_stop() {
+    if (!atomic_get(&progress_running)) {
+        progress_info = NULL;           /* its figures may be gone with it */
+        return;
     }
+    atomic_put(&progress_running, 0);
+#ifdef _USE_THREADS_
+    thread_join(progress_thread);
+#endif
+    progress_info = NULL;               /* the renderer is done reading it */
+    fputs("\x1b[2K\r", stdout);
+    fflush(stdout);
 }
 
 #endif
\ No newline at end of file
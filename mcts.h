@@ -0,0 +1,387 @@
+/*
+ * MCTS.H: Tic-Tac-Toe AI Monte Carlo tree search
+ * -------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ */
+#ifndef _TICTACTOE_MINIMAX_MCTS_H_
+#define _TICTACTOE_MINIMAX_MCTS_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "defs.h"
+#include "thread.h"
+#include "board.h"
+
+/* Every iteration walks down the tree by UCT, grows it by the children of
+ * the node it stops at, plays the game out at random from there and
+ * credits the result to every node on the way. Nodes come from one arena:
+ * the children of a node sit next to each other and nothing is freed on
+ * its own. Between moves the subtree of the position actually reached is
+ * kept, the arena starts over once half of it is spent.
+ *
+ * Threads either walk one shared tree or grow a tree each. In the shared
+ * tree a walk counts its visits on the way down, before the result is
+ * known: until it comes back the path looks like a loss and the other
+ * threads turn to other branches. The first thread to reach a leaf claims
+ * it by a compare-and-swap and hands its children out of the arena, the
+ * others play out from the leaf meanwhile. With a tree each, the visits of
+ * the root moves are added up over the trees when time is up.
+ */
+#define MCTS_NODES      (1 << 20)       /* arena size, 16 MB */
+#define MCTS_PLAYOUTS   20000           /* playouts a move when not timed */
+#define MCTS_EXPLORE    1.4             /* UCT exploration constant */
+#define MCTS_VIRTUAL    1               /* visits a walk counts as a loss until it returns */
+#define MCTS_LEAF       (-1)            /* 'first' of a node not expanded */
+#define MCTS_BUSY       (-2)            /* 'first' while a thread expands the node */
+
+typedef enum {                          /* game state after a node's move */
+    MCTS_OPEN, MCTS_WON, MCTS_DRAWN
+} mcts_state;
+
+typedef struct {                        /* what every thread of a search shares */
+    engine_ctx * ctx;                   /* context that started the search */
+    int64_t deadline;                   /* 0 = run to the playout count */
+    int limit;                          /* playouts of all threads together */
+    int count;                          /* playouts handed out so far */
+} mcts_search;
+
+typedef struct {                        /* what a worker thread is given */
+    mcts_search * search;
+    mcts_tree * tree;                   /* the shared tree or its own */
+    uint64_t seed;                      /* its own random playouts */
+    int done;                           /* playouts it made */
+} mcts_job;
+
+/* =============== PROTOTYPES ==================== */
+
+bool mcts_init(mcts_tree * t, int size);
+
+void mcts_free(mcts_tree * t);
+
+void mcts_reset(mcts_tree * t, game_board * g, char mover);
+
+bool mcts_follow(mcts_tree * t, game_board * g, char mover);
+
+void mcts_advance(mcts_tree * t, int sq);
+
+int32_t mcts_expand(mcts_tree * t, mcts_node * node, bitmask x, bitmask o, char side);
+
+mcts_node * mcts_select(mcts_tree * t, mcts_node * node, int32_t first);
+
+char mcts_playout(bitmask x, bitmask o, char side, uint64_t * seed);
+
+void mcts_iterate(mcts_tree * t, uint64_t * seed);
+
+void mcts_tally(mcts_tree * t, int64_t * visits);
+
+void * mcts_worker(void * arg);
+
+bool mcts_ready(engine_ctx * owner, game_board * g, char mover);
+
+int mcts_move(engine_ctx * ctx);
+
+/* =============================================== */
+
+/* xorshift64*, one state per thread */
+static inline uint64_t mcts_random(uint64_t * seed) {
+    *seed ^= *seed >> 12;
+    *seed ^= *seed << 25;
+    *seed ^= *seed >> 27;
+    return *seed * 0x2545F4914F6CDD1DULL;
+}
+
+/* does a piece on 'sq' complete a window of 'mine'? */
+static inline bool mcts_wins(bitmask mine, int sq) {
+    for (int i = 0; i < cell_line_count[sq]; i++)
+        if ((mine & line_masks[cell_lines[sq][i]]) == line_masks[cell_lines[sq][i]])
+            return true;
+    return false;
+}
+
+static inline char other_side(char side) {
+    return side == CELL_X ? CELL_O : CELL_X;
+}
+
+bool mcts_init(mcts_tree * t, int size) {
+    memset(t, 0, sizeof(mcts_tree));
+    t->nodes = (mcts_node *)malloc(size * sizeof(mcts_node));
+    if (!t->nodes) return false;
+    t->size = size;
+    t->seed = 0x9E3779B97F4A7C15ULL;
+    return true;
+}
+
+void mcts_free(mcts_tree * t) {
+    free(t->nodes);
+    t->nodes = NULL;
+    t->size = t->used = 0;
+}
+
+/* an empty tree rooted at 'g' with 'mover' to move */
+void mcts_reset(mcts_tree * t, game_board * g, char mover) {
+    mcts_node * root = &t->nodes[0];
+    memset(root, 0, sizeof(mcts_node));
+    root->first = MCTS_LEAF;
+    t->used = 1;
+    t->root = 0;
+    t->x = g->x;
+    t->o = g->o;
+    t->mover = mover;
+}
+
+/* move the root down to 'g' if it is the old root plus the reply
+ * that was made there, false if the tree has to start over
+ */
+bool mcts_follow(mcts_tree * t, game_board * g, char mover) {
+    mcts_node * root = &t->nodes[t->root];
+    bitmask mine = t->mover == CELL_X ? g->x : g->o;
+    bitmask theirs = t->mover == CELL_X ? g->o : g->x;
+    bitmask old = t->mover == CELL_X ? t->x : t->o;
+    bitmask added;
+
+    if (!t->used || 2 * t->used > t->size) return false;   /* arena mostly spent */
+    if ((t->x & ~g->x) || (t->o & ~g->o)) return false;     /* another game */
+    if (theirs != (t->mover == CELL_X ? t->o : t->x)) return false;
+    added = mine & ~old;
+    if (!added && t->mover == mover) return true;           /* the same position */
+    if (!added || (added & (added - 1)) || t->mover == mover) return false;
+    if (root->first < 0) return false;
+
+    for (int i = 0; i < root->count; i++)
+        if (((bitmask)1 << t->nodes[root->first + i].move) == added) {
+            t->root = root->first + i;
+            t->x = g->x;
+            t->o = g->o;
+            t->mover = mover;
+            return true;
+        }
+    return false;
+}
+
+/* play 'sq' at the root, the tree starts over if it never looked at it */
+void mcts_advance(mcts_tree * t, int sq) {
+    mcts_node * root = &t->nodes[t->root];
+
+    if (t->mover == CELL_X) t->x |= (bitmask)1 << sq;
+    else                    t->o |= (bitmask)1 << sq;
+    t->mover = other_side(t->mover);
+    for (int i = 0; root->first >= 0 && i < root->count; i++)
+        if (t->nodes[root->first + i].move == sq) {
+            t->root = root->first + i;
+            return;
+        }
+    t->used = 0;                        /* mcts_follow() refuses it */
+}
+
+/* give a node one child per move of 'side' and return the first of them,
+ * or -1 if another thread expands it or the arena is full
+ */
+int32_t mcts_expand(mcts_tree * t, mcts_node * node, bitmask x, bitmask o, char side) {
+    bitmask empty = FULL_MASK & ~(x | o), mine = side == CELL_X ? x : o;
+    int32_t first, leaf = MCTS_LEAF;
+    int sq, n = 0, count;
+
+#if K_IN_A_ROW
+    if ((x | o) && (empty & grow(x | o)))   /* near the pieces, as gen_moves() */
+        empty &= grow(x | o);
+#endif
+    count = bit_count(empty);
+    if (!atomic_cas(&node->first, &leaf, MCTS_BUSY)) return -1;
+    do {                                /* claim 'count' nodes of the arena */
+        first = atomic_get(&t->used);
+        if (first + count > t->size) {
+            atomic_release(&node->first, MCTS_LEAF);
+            return -1;
+        }
+    } while (!atomic_cas(&t->used, &first, first + count));
+
+    for (int i = 0; i < CELL_COUNT; i++) {
+        sq = move_order[i];
+        if (!(empty & ((bitmask)1 << sq))) continue;
+        mcts_node * child = &t->nodes[first + n++];
+        memset(child, 0, sizeof(mcts_node));
+        child->first = MCTS_LEAF;
+        child->move = sq;
+        if (mcts_wins(mine | ((bitmask)1 << sq), sq)) child->state = MCTS_WON;
+        else if (((x | o) | ((bitmask)1 << sq)) == FULL_MASK) child->state = MCTS_DRAWN;
+    }
+    node->count = n;
+    atomic_release(&node->first, first);    /* the children are ready */
+    return first;
+}
+
+/* the child to walk into: a winning move, an untried one, else by UCT */
+mcts_node * mcts_select(mcts_tree * t, mcts_node * node, int32_t first) {
+    mcts_node * child, * best = NULL;
+    double value, top = -1.0;
+    double explore = MCTS_EXPLORE * sqrt(log((double)atomic_get(&node->visits) + 1));
+    int32_t visits;
+
+    for (int i = 0; i < node->count; i++) {
+        child = &t->nodes[first + i];
+        if (child->state == MCTS_WON) return child;
+        visits = atomic_get(&child->visits);
+        if (visits == 0) {
+            if (top < 1e9) best = child;
+            top = 1e9;
+            continue;
+        }
+        value = atomic_get(&child->score) / (2.0 * visits) + explore / sqrt((double)visits);
+        if (value > top) {
+            top = value;
+            best = child;
+        }
+    }
+    return best;
+}
+
+/* random game from the position, returns the winner or CELL_E for a draw */
+char mcts_playout(bitmask x, bitmask o, char side, uint64_t * seed) {
+    bitmask empty = FULL_MASK & ~(x | o), m;
+    int sq, k;
+
+    while (empty) {
+        k = (int)(mcts_random(seed) % (uint64_t)bit_count(empty));
+        for (m = empty; k > 0; k--) m &= m - 1;     /* the k-th empty cell */
+        sq = bit_scan(m);
+        empty &= ~((bitmask)1 << sq);
+        if (side == CELL_X) {
+            x |= (bitmask)1 << sq;
+            if (mcts_wins(x, sq)) return CELL_X;
+        } else {
+            o |= (bitmask)1 << sq;
+            if (mcts_wins(o, sq)) return CELL_O;
+        }
+        side = other_side(side);
+    }
+    return CELL_E;
+}
+
+/* one walk down the tree, a playout and the credit on the way back */
+void mcts_iterate(mcts_tree * t, uint64_t * seed) {
+    mcts_node * path[CELL_COUNT + 1], * node = &t->nodes[t->root];
+    bitmask x = t->x, o = t->o;
+    char side = t->mover, winner, mover;
+    int32_t first, before;
+    int len = 0;
+
+    before = atomic_add(&node->visits, MCTS_VIRTUAL);
+    path[len++] = node;
+    while (node->state == MCTS_OPEN) {
+        first = atomic_acquire(&node->first);
+        if (first == MCTS_BUSY) break;  /* being expanded, play out from here */
+        if (first == MCTS_LEAF) {
+            if (len > 1 && before == 0) break;  /* a new leaf is played out first */
+            if ((first = mcts_expand(t, node, x, o, side)) < 0) break;
+        }
+        node = mcts_select(t, node, first);
+        if (side == CELL_X) x |= (bitmask)1 << node->move;
+        else                o |= (bitmask)1 << node->move;
+        side = other_side(side);
+        before = atomic_add(&node->visits, MCTS_VIRTUAL);
+        path[len++] = node;
+    }
+
+    if (node->state == MCTS_WON)        winner = other_side(side);
+    else if (node->state == MCTS_DRAWN) winner = CELL_E;
+    else                                winner = mcts_playout(x, o, side, seed);
+
+    /* the root was moved into by the other side of its mover */
+    mover = other_side(t->mover);
+    for (int i = 0; i < len; i++, mover = other_side(mover)) {
+        if (MCTS_VIRTUAL != 1) atomic_add(&path[i]->visits, 1 - MCTS_VIRTUAL);
+        if (winner != other_side(mover))
+            atomic_add(&path[i]->score, winner == mover ? 2 : 1);
+    }
+}
+
+/* add the visits of the root moves to 'visits', a won move counts most */
+void mcts_tally(mcts_tree * t, int64_t * visits) {
+    mcts_node * root = &t->nodes[t->root], * child;
+
+    for (int i = 0; root->first >= 0 && i < root->count; i++) {
+        child = &t->nodes[root->first + i];
+        visits[child->move] += child->state == MCTS_WON ? INT32_MAX : child->visits;
+    }
+}
+
+/* playouts until the count or the clock runs out, or the search is stopped */
+void * mcts_worker(void * arg) {
+    mcts_job * job = (mcts_job *)arg;
+    mcts_search * s = job->search;
+    int i;
+
+    for (job->done = 0; ; job->done++) {
+        i = atomic_add(&s->count, 1);
+        if (!s->deadline && i >= s->limit) break;
+        if ((job->done & 63) == 0) {
+            atomic_put(&s->ctx->live.nodes, i);
+            if (s->deadline && clock_ms() >= s->deadline) break;
+            if (s->ctx->stop && atomic_get(s->ctx->stop)) break;
+        }
+        mcts_iterate(job->tree, &job->seed);
+    }
+    return NULL;
+}
+
+/* the tree of 'owner' made on first use and rooted at 'g' */
+bool mcts_ready(engine_ctx * owner, game_board * g, char mover) {
+    mcts_tree * t = owner->mcts;
+
+    if (!t) {
+        t = (mcts_tree *)malloc(sizeof(mcts_tree));
+        if (!t || !mcts_init(t, MCTS_NODES)) {
+            free(t);
+            return false;
+        }
+        owner->mcts = t;
+    }
+    if (!mcts_follow(t, g, mover)) mcts_reset(t, g, mover);
+    return true;
+}
+
+/* pick the computer's move by playouts from the kept trees */
+int mcts_move(engine_ctx * ctx) {
+    mcts_search s;
+    mcts_job jobs[MAX_THREADS];
+    thread_t tid[MAX_THREADS];
+    engine_ctx * owner;
+    int64_t visits[CELL_COUNT] = { 0 };
+    int i, started, trees, sq = -1;
+
+    s.ctx = ctx;
+    s.deadline = ctx->time_budget > 0 ? clock_ms() + ctx->time_budget : 0;
+    s.limit = ctx->playouts > 0 ? ctx->playouts : MCTS_PLAYOUTS;
+    s.count = 0;
+    trees = ctx->mcts_mode == MCTS_ROOTS ? ctx->threads : 1;
+    for (i = 0; i < trees; i++) {
+        owner = i ? &ctx->helpers[i - 1] : ctx;
+        if (!mcts_ready(owner, &ctx->board, ctx->computer)) return -1;
+    }
+    for (i = 0; i < ctx->threads; i++) {
+        jobs[i].search = &s;
+        jobs[i].tree = i < trees && i ? ctx->helpers[i - 1].mcts : ctx->mcts;
+        jobs[i].seed = mcts_random(&ctx->mcts->seed) | 1;
+    }
+
+    for (started = 1; started < ctx->threads; started++)
+        if (!thread_start(&tid[started], mcts_worker, &jobs[started])) break;
+    mcts_worker(&jobs[0]);              /* this thread plays out too */
+    for (i = 1; i < started; i++) thread_join(tid[i]);
+
+    ctx->states = 0;
+    for (i = 0; i < started; i++) ctx->states += jobs[i].done;
+    for (i = 0; i < trees; i++) mcts_tally(jobs[i].tree, visits);
+    for (i = 0; i < CELL_COUNT; i++)    /* the most played move over all trees */
+        if (visits[move_order[i]] && (sq < 0 || visits[move_order[i]] > visits[sq]))
+            sq = move_order[i];
+    if (sq < 0) return -1;
+
+    for (i = 0; i < trees; i++) mcts_advance(jobs[i].tree, sq);
+    atomic_put(&ctx->live.best, sq);
+    return sq;
+}
+
+#endif
@@ -0,0 +1,294 @@
+/*
+ * PNS.H: Tic-Tac-Toe AI proof-number search
+ * ------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ */
+#ifndef _TICTACTOE_MINIMAX_PNS_H_
+#define _TICTACTOE_MINIMAX_PNS_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include "defs.h"
+#include "thread.h"
+#include "board.h"
+
+/* Proof-number search answers one question, does the attacker have a forced
+ * win, instead of scoring a position. Every node counts the frontier nodes
+ * still to be proven (pn) or disproven (dn) to settle it, and the search
+ * always grows the tree where the fewest are left. A draw counts as a
+ * disproof, so there is no depth limit: only the node cap or the clock
+ * stops it.
+ *
+ * PN2: a frontier node of the tree is not simply expanded but searched by
+ * a second proof-number search of its own, as large as the first tree is
+ * by now but no larger than PNS_SECOND. Only the children of that second
+ * tree are kept, with its proof and disproof numbers, so the first tree
+ * stays small and well informed.
+ * The attacker only tries cells next to the pieces under k-in-a-row rules,
+ * the defender every cell: a proof holds on the whole board, a disproof
+ * there only says that no win was found among the attacker's near moves.
+ */
+#define PNS_NODES       (1 << 20)       /* node cap of both trees, 20 MB */
+#define PNS_SECOND      (1 << 12)       /* most nodes of a second level search */
+#define PNS_TIME_MS     5000            /* clock of "am I lost?" when not timed */
+#define PNS_EXPANSIONS  (1 << 15)       /* nodes expanded for an untimed move */
+#define PN_INF          0x3FFFFFFF      /* proof or disproof out of reach */
+#define PNS_ROOT        (-1)            /* 'parent' of the root */
+
+typedef enum {                          /* outcome of a proof-number search */
+    PNS_UNKNOWN,                        /* the cap or the clock ran out */
+    PNS_PROVEN,                         /* the attacker wins by force */
+    PNS_DISPROVEN                       /* no win found, see the k-in-a-row note */
+} pns_result;
+
+typedef struct {                        /* a position of the proof tree, 20 bytes */
+    int32_t parent;                     /* index of the parent, -1 = root */
+    int32_t first;                      /* first of its children, -1 = frontier */
+    uint32_t pn, dn;                    /* proof and disproof numbers */
+    uint8_t move;                       /* cell played to get here */
+    uint8_t count;                      /* number of children */
+    uint8_t attack;                     /* the attacker is to move here */
+    uint8_t spare;
+} pn_node;
+
+typedef struct {                        /* proof tree in one node arena */
+    pn_node * nodes;
+    int size;                           /* nodes in the arena */
+    int used;                           /* nodes handed out so far */
+} pn_tree;
+
+typedef struct {                        /* a proof-number search */
+    pn_tree outer;                      /* tree kept over the search */
+    pn_tree inner;                      /* second level tree of PN2, reused */
+    char attacker;                      /* side that is to be proven to win */
+    int64_t deadline;                   /* 0 = only the node cap */
+    int * stop;                         /* raised to give up, if set */
+    int64_t budget;                     /* most nodes to expand, 0 = no limit */
+    int64_t expanded;                   /* nodes expanded on both levels */
+} pns_ctx;
+
+/* =============== PROTOTYPES ==================== */
+
+bool pns_init(pns_ctx * p, int nodes);
+
+void pns_free(pns_ctx * p);
+
+bool pns_expand(pns_ctx * p, pn_tree * t, int index, game_board * g, char side);
+
+void pns_update(pn_tree * t, int index);
+
+void pns_deepen(pns_ctx * p, int index, game_board * g, char side);
+
+int pns_run(pns_ctx * p, pn_tree * t, game_board * g, char mover, int limit, bool second);
+
+int pns_prove(pns_ctx * p, game_board * g, char attacker, char mover, int * move);
+
+int pns_move(engine_ctx * ctx);
+
+int pns_lost(engine_ctx * ctx);
+
+/* =============================================== */
+
+static inline uint32_t pn_add(uint32_t a, uint32_t b) {
+    return a + b >= PN_INF ? PN_INF : a + b;
+}
+
+/* two trees out of one cap, the second level gets a quarter at most */
+bool pns_init(pns_ctx * p, int nodes) {
+    memset(p, 0, sizeof(pns_ctx));
+    if (nodes < 8) nodes = 8;
+    p->inner.size = nodes / 4 < PNS_SECOND ? nodes / 4 : PNS_SECOND;
+    p->outer.size = nodes - p->inner.size;
+    p->outer.nodes = (pn_node *)malloc(p->outer.size * sizeof(pn_node));
+    p->inner.nodes = (pn_node *)malloc(p->inner.size * sizeof(pn_node));
+    if (!p->outer.nodes || !p->inner.nodes) {
+        pns_free(p);
+        return false;
+    }
+    return true;
+}
+
+void pns_free(pns_ctx * p) {
+    free(p->outer.nodes);
+    free(p->inner.nodes);
+    memset(p, 0, sizeof(pns_ctx));
+}
+
+/* give a frontier node one child per move of 'side', numbers set by the
+ * game state after the move; false if the arena is full
+ */
+bool pns_expand(pns_ctx * p, pn_tree * t, int index, game_board * g, char side) {
+    pn_node * node = &t->nodes[index], * child;
+    bitmask cells = empty_cells(g);
+    int moves[CELL_COUNT], n = 0, sq;
+
+    if (side == p->attacker) n = gen_moves(g, moves);   /* near the pieces */
+    else
+        for (int i = 0; i < CELL_COUNT; i++)            /* every cell */
+            if (cells & ((bitmask)1 << move_order[i])) moves[n++] = move_order[i];
+    if (t->used + n > t->size) return false;
+
+    node->first = t->used;
+    node->count = n;
+    for (int i = 0; i < n; i++) {
+        sq = moves[i];
+        child = &t->nodes[t->used++];
+        memset(child, 0, sizeof(pn_node));
+        child->parent = index;
+        child->first = -1;
+        child->move = sq;
+        child->attack = !node->attack;
+        place(g, sq, side);
+        if (wins_at(g, sq, side)) {     /* over: proven if the attacker won */
+            child->pn = side == p->attacker ? 0 : PN_INF;
+            child->dn = side == p->attacker ? PN_INF : 0;
+        } else if (!empty_cells(g)) {   /* a draw is no win */
+            child->pn = PN_INF;
+            child->dn = 0;
+        } else {
+            child->pn = child->dn = 1;
+        }
+        unplace(g, sq, side);
+    }
+    p->expanded++;
+    return true;
+}
+
+/* numbers of 'index' and its ancestors from those of their children */
+void pns_update(pn_tree * t, int index) {
+    pn_node * node, * child;
+    uint32_t pn, dn;
+
+    for (; index != PNS_ROOT; index = node->parent) {
+        node = &t->nodes[index];
+        if (node->attack) {             /* one proven move is enough */
+            pn = PN_INF;
+            dn = 0;
+        } else {                        /* every reply has to be proven */
+            pn = 0;
+            dn = PN_INF;
+        }
+        for (int i = 0; i < node->count; i++) {
+            child = &t->nodes[node->first + i];
+            if (node->attack) {
+                if (child->pn < pn) pn = child->pn;
+                dn = pn_add(dn, child->dn);
+            } else {
+                pn = pn_add(pn, child->pn);
+                if (child->dn < dn) dn = child->dn;
+            }
+        }
+        node->pn = pn;
+        node->dn = dn;
+    }
+}
+
+/* PN2: search a new frontier node on its own, keep the numbers of its children */
+void pns_deepen(pns_ctx * p, int index, game_board * g, char side) {
+    pn_node * node = &p->outer.nodes[index], * root = &p->inner.nodes[0];
+    int limit = p->outer.used < p->inner.size ? p->outer.used : p->inner.size;
+
+    pns_run(p, &p->inner, g, side, limit, false);
+    if (root->first < 0 || root->count != node->count) return;
+    for (int i = 0; i < node->count; i++) {
+        p->outer.nodes[node->first + i].pn = p->inner.nodes[root->first + i].pn;
+        p->outer.nodes[node->first + i].dn = p->inner.nodes[root->first + i].dn;
+    }
+}
+
+/* grow the tree from 'g' until the root is settled or 'limit' nodes
+ * are used, by PN2 if 'second' is set
+ */
+int pns_run(pns_ctx * p, pn_tree * t, game_board * g, char mover, int limit, bool second) {
+    pn_node * root = &t->nodes[0], * node, * child;
+    game_board b;
+    char side;
+    int index, i;
+    int64_t rounds = 0;
+
+    memset(root, 0, sizeof(pn_node));
+    root->parent = PNS_ROOT;
+    root->first = -1;
+    root->attack = mover == p->attacker;
+    root->pn = root->dn = 1;
+    t->used = 1;
+
+    while (root->pn && root->dn && t->used < limit) {
+        if (p->budget && p->expanded >= p->budget) break;
+        if ((++rounds & 255) == 0 && ((p->deadline && clock_ms() >= p->deadline)
+                                   || (p->stop && atomic_get(p->stop)))) break;
+        b = *g;
+        side = mover;
+        index = 0;
+        while ((node = &t->nodes[index])->first >= 0) {     /* the most proving node */
+            for (i = 0; i < node->count; i++) {
+                child = &t->nodes[node->first + i];
+                if (node->attack ? child->pn == node->pn : child->dn == node->dn) break;
+            }
+            if (i == node->count) i = 0;
+            index = node->first + i;
+            place(&b, t->nodes[index].move, side);
+            side = side == CELL_X ? CELL_O : CELL_X;
+        }
+        if (!pns_expand(p, t, index, &b, side)) break;     /* the arena is full */
+        if (second) pns_deepen(p, index, &b, side);
+        pns_update(t, index);
+    }
+    return root->pn == 0 ? PNS_PROVEN : root->dn == 0 ? PNS_DISPROVEN : PNS_UNKNOWN;
+}
+
+/* does 'attacker' win by force from 'g' with 'mover' to move? 'move'
+ * gets the winning move when the attacker is to move and it does
+ */
+int pns_prove(pns_ctx * p, game_board * g, char attacker, char mover, int * move) {
+    pn_node * root = &p->outer.nodes[0];
+    int result;
+
+    p->attacker = attacker;
+    p->expanded = 0;
+    *move = -1;
+    if (!empty_cells(g)) return PNS_DISPROVEN;
+    result = pns_run(p, &p->outer, g, mover, p->outer.size, true);
+    if (result == PNS_PROVEN && root->attack)
+        for (int i = 0; i < root->count; i++)
+            if (p->outer.nodes[root->first + i].pn == 0) {
+                *move = p->outer.nodes[root->first + i].move;
+                break;
+            }
+    return result;
+}
+
+/* a proven winning move for the computer, -1 if none is found; a timed
+ * move gives up at ctx->deadline, an untimed one after PNS_EXPANSIONS
+ */
+int pns_move(engine_ctx * ctx) {
+    pns_ctx p;
+    int sq = -1;
+
+    if (!pns_init(&p, ctx->pns_nodes)) return -1;
+    p.deadline = ctx->deadline;
+    p.budget = ctx->deadline ? 0 : PNS_EXPANSIONS;
+    p.stop = ctx->stop;
+    if (pns_prove(&p, &ctx->board, ctx->computer, ctx->computer, &sq) == PNS_PROVEN)
+        atomic_put(&ctx->live.best, sq);
+    ctx->states = (int)p.expanded;
+    atomic_put(&ctx->live.nodes, ctx->states);
+    pns_free(&p);
+    return sq;
+}
+
+/* is the human, to move, lost against best play? a pns_result */
+int pns_lost(engine_ctx * ctx) {
+    pns_ctx p;
+    int result, sq;
+
+    if (!pns_init(&p, ctx->pns_nodes)) return PNS_UNKNOWN;
+    p.deadline = clock_ms() + (ctx->time_budget > 0 ? ctx->time_budget : PNS_TIME_MS);
+    result = pns_prove(&p, &ctx->board, ctx->computer, ctx->human, &sq);
+    ctx->states = (int)p.expanded;
+    pns_free(&p);
+    return result;
+}
+
+#endif
@@ -0,0 +1,267 @@
+/*
+ * SOLVER.H: Tic-Tac-Toe AI retrograde analysis solver
+ * ---------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ */
+#ifndef _TICTACTOE_MINIMAX_SOLVER_H_
+#define _TICTACTOE_MINIMAX_SOLVER_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "defs.h"
+#include "thread.h"
+#include "board.h"
+#include "db.h"
+
+/* Every position with X to move is solved once, layer by layer of piece
+ * count from the full board back to the empty one: a position only needs
+ * the values of the positions one piece longer, all solved already. A
+ * finished line scores as evaluate() does, a full board is a draw. The
+ * values are laid out as in the database of db.h.
+ *
+ * The masks of X's of a layer are split into one range per worker. A
+ * worker takes masks from the front of its own range; once it runs dry
+ * it steals the back half of the fullest range left.
+ */
+#define SOLVER_MAX_CELLS    16          /* 4x4: 3^16 codes, about 10 MB */
+
+#define RANGE_PACK(lo, hi)  (((uint64_t)(uint32_t)(hi) << 32) | (uint32_t)(lo))
+#define RANGE_LO(r)         ((int)(uint32_t)(r))
+#define RANGE_HI(r)         ((int)((r) >> 32))
+
+typedef struct {                    /* what a worker thread is given */
+    solver_ctx * solver;
+    int id;                         /* its own range */
+} solver_job;
+
+/* =============== PROTOTYPES ==================== */
+
+bool solver_init(solver_ctx * s, int threads);
+
+void solver_free(solver_ctx * s);
+
+int solve_position(solver_ctx * s, bitmask mover, bitmask other);
+
+bool solver_next(solver_ctx * s, int id, int * index);
+
+void * solver_worker(void * arg);
+
+void solver_run(solver_ctx * s);
+
+void solver_report(solver_ctx * s, FILE * f);
+
+bool solver_write(solver_ctx * s, const char * path);
+
+void solver_db(solver_ctx * s, solved_db * db);
+
+/* =============================================== */
+
+/* allocate the value array and tables, false if the board is too big */
+bool solver_init(solver_ctx * s, int threads) {
+    int i, masks = 1 << (CELL_COUNT <= SOLVER_MAX_CELLS ? CELL_COUNT : 0);
+    int fill[CELL_COUNT + 2];
+
+    memset(s, 0, sizeof(solver_ctx));
+    if (CELL_COUNT > SOLVER_MAX_CELLS) return false;
+    init_masks();
+    s->codes = (uint32_t)(pow3[CELL_COUNT - 1] * 3);
+    s->threads = threads < 1 ? 1 : threads > MAX_THREADS ? MAX_THREADS : threads;
+    s->values = (uint8_t *)calloc(DB_BYTES(s->codes), 1);
+    s->code3 = (uint32_t *)malloc(masks * sizeof(uint32_t));
+    s->masks = (int *)malloc(masks * sizeof(int));
+    if (!s->values || !s->code3 || !s->masks) {
+        solver_free(s);
+        return false;
+    }
+
+    for (i = 0; i < masks; i++) {       /* codes, and masks by piece count */
+        s->code3[i] = i ? s->code3[i & (i - 1)] + (uint32_t)pow3[bit_scan(i)] : 0;
+        s->starts[bit_count(i) + 1]++;
+    }
+    for (i = 1; i <= CELL_COUNT + 1; i++) s->starts[i] += s->starts[i-1];
+    memcpy(fill, s->starts, sizeof(fill));
+    for (i = 0; i < masks; i++) s->masks[fill[bit_count(i)]++] = i;
+    return true;
+}
+
+void solver_free(solver_ctx * s) {
+    free(s->values);
+    free(s->code3);
+    free(s->masks);
+    memset(s, 0, sizeof(solver_ctx));
+}
+
+/* value of a position with 'mover' to move, all longer games solved */
+int solve_position(solver_ctx * s, bitmask mover, bitmask other) {
+    bitmask m, next;
+    int sq, v, best = DB_NONE;
+    uint32_t code;                      /* bytes are shared with the layer being written */
+
+    for (int i = 0; i < LINE_COUNT; i++)    /* over already */
+        if ((mover & line_masks[i]) == line_masks[i]
+        ||  (other & line_masks[i]) == line_masks[i]) return DB_NONE;
+    if ((mover | other) == FULL_MASK) return DB_DRAW;
+
+    for (m = FULL_MASK & ~(mover | other); m; m &= m - 1) {
+        sq = bit_scan(m);
+        next = mover | ((bitmask)1 << sq);
+        for (int i = 0; i < cell_line_count[sq]; i++)
+            if ((next & line_masks[cell_lines[sq][i]]) == line_masks[cell_lines[sq][i]])
+                return DB_WIN;
+        if ((next | other) == FULL_MASK) v = DB_DRAW;   /* last cell filled */
+        else {                          /* the reply, the other side to move */
+            code = s->code3[other] + 2 * s->code3[next];
+            v = (atomic_get(&s->values[code >> 2]) >> ((code & 3) * 2)) & 3;
+            v = v == DB_WIN ? DB_LOSS : v == DB_LOSS ? DB_WIN : v;
+        }
+        if (v > best) best = v;
+    }
+    return best;
+}
+
+/* next mask index for worker 'id': its own range first, then stolen work */
+bool solver_next(solver_ctx * s, int id, int * index) {
+    uint64_t r, want;
+    int lo, hi, mid, victim, most;
+
+    for (;;) {
+        r = atomic_get(&s->ranges[id]);
+        lo = RANGE_LO(r);
+        hi = RANGE_HI(r);
+        if (lo < hi) {                  /* take the front of our own range */
+            if (atomic_cas(&s->ranges[id], &r, RANGE_PACK(lo + 1, hi))) {
+                *index = lo;
+                return true;
+            }
+            continue;
+        }
+
+        victim = -1;                    /* the fullest range of the others */
+        most = 1;
+        for (int i = 0; i < s->threads; i++) {
+            r = atomic_get(&s->ranges[i]);
+            if (RANGE_HI(r) - RANGE_LO(r) > most) {
+                most = RANGE_HI(r) - RANGE_LO(r);
+                victim = i;
+            }
+        }
+        if (victim < 0) {               /* single masks left are not split */
+            for (int i = 0; i < s->threads; i++) {
+                r = atomic_get(&s->ranges[i]);
+                lo = RANGE_LO(r);
+                if (lo < RANGE_HI(r)
+                &&  atomic_cas(&s->ranges[i], &r, RANGE_PACK(lo + 1, RANGE_HI(r)))) {
+                    *index = lo;
+                    return true;
+                }
+            }
+            return false;               /* the layer is done */
+        }
+
+        r = atomic_get(&s->ranges[victim]);
+        lo = RANGE_LO(r);
+        hi = RANGE_HI(r);
+        if (hi - lo < 2) continue;
+        mid = lo + (hi - lo) / 2;
+        want = RANGE_PACK(lo, mid);
+        if (atomic_cas(&s->ranges[victim], &r, want))   /* the back half is ours */
+            atomic_put(&s->ranges[id], RANGE_PACK(mid, hi));
+    }
+}
+
+/* solve the positions of the running layer, one mask of X's at a time */
+void * solver_worker(void * arg) {
+    solver_job * job = (solver_job *)arg;
+    solver_ctx * s = job->solver;
+    int index, x, o, open, v, nx = s->layer / 2, no = s->layer - nx;
+    int64_t solved = 0;
+    uint32_t code;
+
+    /* X to move: as many O's as X's, or one more when O began */
+    while (solver_next(s, job->id, &index)) {
+        x = s->masks[index];
+        open = FULL_MASK & ~x;
+        for (o = open; ; o = (o - 1) & open) {  /* every O mask that fits */
+            if (bit_count(o) == no && (v = solve_position(s, x, o)) != DB_NONE) {
+                code = s->code3[x] + 2 * s->code3[o];
+                atomic_or(&s->values[code >> 2], (uint8_t)(v << ((code & 3) * 2)));
+                solved++;
+            }
+            if (!o) break;
+        }
+    }
+    atomic_add(&s->positions, solved);
+    return NULL;
+}
+
+/* solve the whole board, one layer after another */
+void solver_run(solver_ctx * s) {
+    thread_t tid[MAX_THREADS];
+    solver_job jobs[MAX_THREADS];
+    int i, started, first, count;
+    int64_t start = clock_ms(), layer_start;
+
+    for (s->layer = CELL_COUNT; s->layer >= 0; s->layer--) {
+        layer_start = clock_ms();
+        first = s->starts[s->layer / 2];
+        count = s->starts[s->layer / 2 + 1] - first;
+        for (i = 0; i < s->threads; i++) {      /* even shares to begin with */
+            jobs[i].solver = s;
+            jobs[i].id = i;
+            s->ranges[i] = RANGE_PACK(first + (int64_t)count * i / s->threads,
+                                      first + (int64_t)count * (i + 1) / s->threads);
+        }
+        s->positions = 0;
+        for (started = 1; started < s->threads; started++)
+            if (!thread_start(&tid[started], solver_worker, &jobs[started])) break;
+        solver_worker(&jobs[0]);        /* this thread works too, and steals */
+        for (i = 1; i < started; i++) thread_join(tid[i]);
+        s->stats[s->layer].positions = s->positions;
+        s->stats[s->layer].ms = clock_ms() - layer_start;
+    }
+    s->layer = 0;
+    s->ms = clock_ms() - start;
+}
+
+/* per layer timings and the overall throughput */
+void solver_report(solver_ctx * s, FILE * f) {
+    int64_t total = 0;
+
+    for (int k = CELL_COUNT; k >= 0; k--) {
+        total += s->stats[k].positions;
+        fprintf(f, "layer %2d: %10lld positions, %6lld ms\n", k,
+                (long long)s->stats[k].positions, (long long)s->stats[k].ms);
+    }
+    fprintf(f, "%lld positions in %lld ms with %d threads, %lld positions/s\n",
+            (long long)total, (long long)s->ms, s->threads,
+            (long long)(total * 1000 / (s->ms > 0 ? s->ms : 1)));
+}
+
+/* save the values as a database file for db_open() */
+bool solver_write(solver_ctx * s, const char * path) {
+    uint8_t header[DB_HEADER] = { 0 };
+    uint32_t size = BOARD_SIZE, length = WIN_LENGTH;
+    size_t bytes = DB_BYTES(s->codes);
+    FILE * f;
+    bool ok;
+
+    if (!s->values || !(f = fopen(path, "wb"))) return false;
+    memcpy(header, DB_MAGIC, 4);
+    memcpy(header + 4, &size, 4);
+    memcpy(header + 8, &s->codes, 4);
+    memcpy(header + 12, &length, 4);
+    ok = fwrite(header, 1, DB_HEADER, f) == DB_HEADER
+      && fwrite(s->values, 1, bytes, f) == bytes;
+    return fclose(f) == 0 && ok;
+}
+
+/* use the values in memory as a database, valid until solver_free() */
+void solver_db(solver_ctx * s, solved_db * db) {
+    memset(db, 0, sizeof(solved_db));
+    db->values = s->values;
+    db->codes = s->codes;
+}
+
+#endif
@@ -0,0 +1,218 @@
+/*
+ * STATS.H: Tic-Tac-Toe AI search statistics
+ * --------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ */
+#ifndef _TICTACTOE_MINIMAX_STATS_H_
+#define _TICTACTOE_MINIMAX_STATS_H_
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "defs.h"
+#include "thread.h"
+
+/* Counters of a move's search: nodes, horizon leaves and beta cutoffs per
+ * ply (0 = the root), table traffic and the nodes and time of every
+ * iteration of the deepening. The search only touches them through the
+ * STAT_ macros, which are empty unless _USE_SEARCH_STATS_ is defined, so
+ * a normal build carries no trace of them. Each helper thread counts in
+ * its own context and is added to the main one when it is joined.
+ */
+#define STATS_COLUMNS   "move,record,index,nodes,leaves,cutoffs,first_cutoffs," \
+                        "probes,hits,stores,overwrites,us"
+
+typedef enum {                          /* how the stats of a move are dumped */
+    STATS_CSV, STATS_JSON
+} stats_format;
+
+#ifdef _USE_SEARCH_STATS_
+    #define STAT_RESET(ctx)         stats_reset(&(ctx)->stats)
+    #define STAT_NODE(ctx, ply)     ((ctx)->stats.nodes[ply]++)
+    #define STAT_LEAF(ctx, ply)     ((ctx)->stats.leaves[ply]++)
+    #define STAT_CUT(ctx, ply, i)   ((ctx)->stats.cutoffs[ply]++,                  \
+                                     (ctx)->stats.first_cutoffs[ply] += (i) == 0)
+    #define STAT_STORE(ctx, r)      stats_store(&(ctx)->stats, (r))
+    #define STAT_MERGE(ctx, h)      stats_merge(&(ctx)->stats, &(h)->stats)
+    #define STAT_ITERATION(ctx, d)  stats_iteration((ctx), (d))
+    #define STAT_DONE(ctx)          stats_done(ctx)
+#else
+    #define STAT_RESET(ctx)         ((void)0)
+    #define STAT_NODE(ctx, ply)     ((void)0)
+    #define STAT_LEAF(ctx, ply)     ((void)0)
+    #define STAT_CUT(ctx, ply, i)   ((void)0)
+    #define STAT_STORE(ctx, r)      ((void)(r))
+    #define STAT_MERGE(ctx, h)      ((void)0)
+    #define STAT_ITERATION(ctx, d)  ((void)0)
+    #define STAT_DONE(ctx)          ((void)0)
+#endif
+
+#ifdef _USE_SEARCH_STATS_
+
+/* =============== PROTOTYPES ==================== */
+
+void stats_reset(search_stats * s);
+
+void stats_store(search_stats * s, int result);
+
+void stats_merge(search_stats * to, search_stats * from);
+
+void stats_iteration(engine_ctx * ctx, int depth);
+
+int64_t stats_nodes(search_stats * s);
+
+double stats_branching(search_stats * s);
+
+void stats_dump(engine_ctx * ctx, FILE * f, int format);
+
+void stats_done(engine_ctx * ctx);
+
+bool stats_open(engine_ctx * ctx, const char * path);
+
+void stats_close(engine_ctx * ctx);
+
+/* =============================================== */
+
+void stats_reset(search_stats * s) {
+    memset(s, 0, sizeof(search_stats));
+    s->start = clock_us();
+}
+
+/* a tt_store result of store_trans_table() */
+void stats_store(search_stats * s, int result) {
+    if (result != TT_KEPT) s->stores++;
+    if (result == TT_REPLACED) s->overwrites++;
+}
+
+/* add the per ply counts of a helper thread */
+void stats_merge(search_stats * to, search_stats * from) {
+    for (int p = 0; p < STATS_PLIES; p++) {
+        to->nodes[p] += from->nodes[p];
+        to->leaves[p] += from->leaves[p];
+        to->cutoffs[p] += from->cutoffs[p];
+        to->first_cutoffs[p] += from->first_cutoffs[p];
+    }
+    to->stores += from->stores;
+    to->overwrites += from->overwrites;
+    memset(from->nodes, 0, sizeof(from->nodes));    /* merged once only */
+    memset(from->leaves, 0, sizeof(from->leaves));
+    memset(from->cutoffs, 0, sizeof(from->cutoffs));
+    memset(from->first_cutoffs, 0, sizeof(from->first_cutoffs));
+    from->stores = from->overwrites = 0;
+}
+
+/* an iteration of the deepening to 'depth' is finished, it gets the
+ * nodes and time of the move not taken by the iterations before it
+ */
+void stats_iteration(engine_ctx * ctx, int depth) {
+    search_stats * s = &ctx->stats;
+    int64_t nodes = ctx->states, us = clock_us() - s->start;
+
+    if (s->iterations >= STATS_PLIES) return;
+    for (int i = 0; i < s->iterations; i++) {
+        nodes -= s->iter_nodes[i];
+        us -= s->iter_us[i];
+    }
+    s->iter_depth[s->iterations] = depth;
+    s->iter_nodes[s->iterations] = nodes;
+    s->iter_us[s->iterations] = us;
+    s->iterations++;
+}
+
+int64_t stats_nodes(search_stats * s) {
+    int64_t total = 0;
+    for (int p = 0; p < STATS_PLIES; p++) total += s->nodes[p];
+    return total;
+}
+
+/* effective branching factor: the growth from one iteration to the next,
+ * or the ply-th root of the nodes of a single search
+ */
+double stats_branching(search_stats * s) {
+    int n = s->iterations, deepest = 0;
+
+    if (n >= 2 && s->iter_nodes[n - 2] > 0)
+        return (double)s->iter_nodes[n - 1] / s->iter_nodes[n - 2];
+    for (int p = 0; p < STATS_PLIES; p++)
+        if (s->nodes[p]) deepest = p;
+    return deepest ? pow((double)stats_nodes(s), 1.0 / deepest) : 0.0;
+}
+
+/* the stats of the last move, one JSON object a line or CSV rows of the
+ * STATS_COLUMNS: a 'total' row, then one per 'ply' and per 'iteration'
+ */
+void stats_dump(engine_ctx * ctx, FILE * f, int format) {
+    search_stats * s = &ctx->stats;
+    int last = 0, p, i;
+
+    for (p = 0; p < STATS_PLIES; p++)
+        if (s->nodes[p] || s->leaves[p]) last = p;
+
+    if (format == STATS_JSON) {
+        fprintf(f, "{\"move\":%d,\"depth\":%d,\"us\":%lld,\"nodes\":%lld,\"ebf\":%.3f,"
+                   "\"tt\":{\"probes\":%lld,\"hits\":%lld,\"stores\":%lld,\"overwrites\":%lld},"
+                   "\"plies\":[",
+                ctx->move_count, ctx->search_depth, (long long)s->us, (long long)stats_nodes(s),
+                stats_branching(s), (long long)s->probes, (long long)s->hits,
+                (long long)s->stores, (long long)s->overwrites);
+        for (p = 0; p <= last; p++)
+            fprintf(f, "%s{\"ply\":%d,\"nodes\":%lld,\"leaves\":%lld,\"cutoffs\":%lld,\"first\":%lld}",
+                    p ? "," : "", p, (long long)s->nodes[p], (long long)s->leaves[p],
+                    (long long)s->cutoffs[p], (long long)s->first_cutoffs[p]);
+        fprintf(f, "],\"iterations\":[");
+        for (i = 0; i < s->iterations; i++)
+            fprintf(f, "%s{\"depth\":%d,\"nodes\":%lld,\"us\":%lld}", i ? "," : "",
+                    s->iter_depth[i], (long long)s->iter_nodes[i], (long long)s->iter_us[i]);
+        fprintf(f, "]}\n");
+    } else {
+        fprintf(f, "%d,total,%d,%lld,,,,%lld,%lld,%lld,%lld,%lld\n", ctx->move_count,
+                ctx->search_depth, (long long)stats_nodes(s), (long long)s->probes,
+                (long long)s->hits, (long long)s->stores, (long long)s->overwrites,
+                (long long)s->us);
+        for (p = 0; p <= last; p++)
+            fprintf(f, "%d,ply,%d,%lld,%lld,%lld,%lld,,,,,\n", ctx->move_count, p,
+                    (long long)s->nodes[p], (long long)s->leaves[p],
+                    (long long)s->cutoffs[p], (long long)s->first_cutoffs[p]);
+        for (i = 0; i < s->iterations; i++)
+            fprintf(f, "%d,iteration,%d,%lld,,,,,,,,%lld\n", ctx->move_count,
+                    s->iter_depth[i], (long long)s->iter_nodes[i], (long long)s->iter_us[i]);
+    }
+    fflush(f);
+}
+
+/* close the books on a move and dump them if a file is set */
+void stats_done(engine_ctx * ctx) {
+    search_stats * s = &ctx->stats;
+
+    if (!s->iterations && ctx->states)  /* one search to a fixed depth */
+        stats_iteration(ctx, ctx->search_depth);
+    s->us = clock_us() - s->start;
+    s->probes = ctx->tt_probes;
+    s->hits = ctx->tt_hits;
+    if (ctx->stats_file) stats_dump(ctx, (FILE *)ctx->stats_file, ctx->stats_format);
+}
+
+/* dump every move to the end of 'path', as JSON if it ends in ".json" */
+bool stats_open(engine_ctx * ctx, const char * path) {
+    size_t length = path ? strlen(path) : 0;
+    FILE * f;
+
+    stats_close(ctx);
+    if (!length || !(f = fopen(path, "a"))) return false;
+    ctx->stats_format = length > 5 && !strcmp(path + length - 5, ".json") ? STATS_JSON : STATS_CSV;
+    fseek(f, 0, SEEK_END);
+    if (ctx->stats_format == STATS_CSV && ftell(f) == 0)
+        fprintf(f, STATS_COLUMNS "\n");   /* a new file starts with the header */
+    ctx->stats_file = f;
+    return true;
+}
+
+void stats_close(engine_ctx * ctx) {
+    if (ctx->stats_file) fclose((FILE *)ctx->stats_file);
+    ctx->stats_file = NULL;
+}
+
+#endif
+
+#endif
@@ -1,7 +1,8 @@
 /* 
  * TEST_ENGINE.C: Validation tests for Tic-Tac-Toe AI engine
  * --------------
- * Tests core game logic and AI behavior
+ * Tests core game logic and AI behavior, built by 'make test' both
+ * without and with -D_USE_SEARCH_STATS_
  */
 #include <stdio.h>
 #include <stdlib.h>
@@ -9,9 +10,12 @@
 #include "../defs.h"
 #include "../helper.h"
 #include "../engine.h"
+#include "../solver.h"
+#include "../batch.h"
 
 int tests_passed = 0;
 int tests_failed = 0;
+engine_ctx ctx;                     /* context shared by the game tests */
 
 #define TEST(name) printf("\n"C_WARNING"[TEST]"C_RESET" %s\n", name)
 #define ASSERT(condition, message) \
@@ -26,28 +30,359 @@ int tests_failed = 0;
 void test_board_initialization() {
     TEST("Board Initialization");
     game_board test_board;
-    init_board(test_board);
+    init_board(&test_board);
     
     int empty_count = 0;
     for (int r = 0; r < BOARD_SIZE; r++)
         for (int c = 0; c < BOARD_SIZE; c++)
-            if (test_board[r][c] == CELL_E) empty_count++;
+            if (get_cell(&test_board, c, r) == CELL_E) empty_count++;
     
     ASSERT(empty_count == BOARD_SIZE * BOARD_SIZE, "All cells are empty");
-    ASSERT(has_move(test_board), "Board has moves available");
+    ASSERT(has_move(&test_board), "Board has moves available");
 }
 
 void test_cell_operations() {
     TEST("Cell Operations");
     game_board test_board;
-    init_board(test_board);
+    init_board(&test_board);
     
-    ASSERT(is_playable(test_board, 0, 0), "Empty cell (0,0) is playable");
-    ASSERT(!is_occupied(test_board, 0, 0), "Empty cell (0,0) is not occupied");
+    ASSERT(is_playable(&test_board, 0, 0), "Empty cell (0,0) is playable");
+    ASSERT(!is_occupied(&test_board, 0, 0), "Empty cell (0,0) is not occupied");
     
-    test_board[0][0] = CELL_X;
-    ASSERT(!is_playable(test_board, 0, 0), "Occupied cell (0,0) is not playable");
-    ASSERT(is_occupied(test_board, 0, 0), "Occupied cell (0,0) is occupied");
+    set_cell(&test_board, 0, 0, CELL_X);
+    ASSERT(!is_playable(&test_board, 0, 0), "Occupied cell (0,0) is not playable");
+    ASSERT(is_occupied(&test_board, 0, 0), "Occupied cell (0,0) is occupied");
+}
+
+void test_bitboard_masks() {
+    TEST("Bitboard Masks");
+    game_board test_board;
+    init_board(&test_board);
+    
+    int lines_ok = 1;
+    for (int i = 0; i < LINE_COUNT; i++)
+        if (bit_count(line_masks[i]) != WIN_LENGTH) lines_ok = 0;
+    ASSERT(lines_ok, "Every line mask covers WIN_LENGTH cells");
+    
+    bitmask all = 0;
+    for (int i = 0; i < CELL_COUNT; i++) all |= (bitmask)1 << move_order[i];
+    ASSERT(all == FULL_MASK, "Static move order covers the board");
+    
+    int moves[CELL_COUNT];
+    ASSERT(gen_moves(&test_board, moves) == CELL_COUNT, "All cells generated on empty board");
+    if (BOARD_SIZE == 3) {
+        ASSERT(moves[0] == 4 && moves[1] == 0 && moves[8] == 7, "Center, corners, then edges");
+    }
+    if (BOARD_SIZE == 4) {
+        ASSERT(moves[0] == 5 && moves[3] == 10 && moves[4] == 0, "Inner diagonal cells, then corners");
+    }
+    
+    set_cell(&test_board, 1, 0, CELL_O);
+    set_cell(&test_board, 1, 0, CELL_X);
+    ASSERT(get_cell(&test_board, 1, 0) == CELL_X && test_board.o == 0, "Overwriting a cell keeps sides apart");
+    ASSERT(gen_moves(&test_board, moves) == CELL_COUNT - 1 || K_IN_A_ROW, "Occupied cell not generated");
+#if K_IN_A_ROW
+    ASSERT(gen_moves(&test_board, moves) == bit_count(grow(test_board.x) & ~test_board.x),
+           "Only cells next to a piece are generated");
+#endif
+}
+
+void test_zobrist_keys() {
+    TEST("Zobrist Keys");
+    new_game(&ctx);
+    
+    ASSERT(ctx.board.keys[0] == 0, "Empty board has a zero key");
+    
+    ctx.human = CELL_O;
+    ctx.computer = CELL_X;
+    human_move(&ctx, 0, 0);
+    uint64_t after_human = ctx.board.keys[0];
+    ASSERT(after_human == zobrist_key(&ctx.board), "Key follows the human move");
+    
+    ctx.game_depth = GAME_MEDIUM;
+    computer_move(&ctx);
+    ASSERT(ctx.board.keys[0] == zobrist_key(&ctx.board), "Key follows the computer move");
+    ASSERT(ctx.board.keys[0] != after_human, "Different positions have different keys");
+    
+    set_cell(&ctx.board, 0, 0, CELL_E);
+    set_cell(&ctx.board, 0, 0, CELL_X);
+    ASSERT(ctx.board.keys[0] == zobrist_key(&ctx.board), "Key follows manual setup");
+}
+
+void test_symmetry() {
+    TEST("Board Symmetries");
+    game_board a, b;
+    int moves[CELL_COUNT], n, sym_a, sym_b, last = BOARD_SIZE - 1;
+    bool inverse = true, keys = true;
+    
+    init_board(&a);
+    for (int t = 0; t < SYMMETRIES; t++)
+        for (int i = 0; i < CELL_COUNT; i++)
+            if (sym_back[t][sym_cell[t][i]] != i) inverse = false;
+    ASSERT(inverse, "Every symmetry can be undone");
+    ASSERT(sym_cell[1][0] == last && sym_cell[4][0] == last, "Turns and mirrors move the corner");
+    
+    /* a position and the same one turned a quarter */
+    set_cell(&a, 0, 0, CELL_X);
+    set_cell(&a, 1, 0, CELL_O);
+    init_board(&b);
+    for (int i = 0; i < CELL_COUNT; i++) {
+        char piece = get_cell(&a, i % BOARD_SIZE, i / BOARD_SIZE);
+        int to = sym_cell[1][i];
+        if (piece != CELL_E) set_cell(&b, to % BOARD_SIZE, to / BOARD_SIZE, piece);
+    }
+    for (int t = 0; t < SYMMETRIES; t++) {
+        game_board c;
+        init_board(&c);
+        for (int i = 0; i < CELL_COUNT; i++) {
+            char piece = get_cell(&a, i % BOARD_SIZE, i / BOARD_SIZE);
+            int to = sym_cell[t][i];
+            if (piece != CELL_E) set_cell(&c, to % BOARD_SIZE, to / BOARD_SIZE, piece);
+        }
+        if (c.keys[0] != a.keys[t]) keys = false;
+    }
+    ASSERT(keys, "Each key is the key of the transformed board");
+    ASSERT(a.keys[0] != b.keys[0] && canonical_key(&a, &sym_a) == canonical_key(&b, &sym_b),
+           "Turned positions share the canonical key");
+    
+    init_board(&a);
+    n = unique_moves(&a, moves, gen_moves(&a, moves));
+    ASSERT(BOARD_SIZE != 3 || n == 3, "Empty 3x3 board has three distinct moves");
+    ASSERT(n < CELL_COUNT / 4 + BOARD_SIZE, "Empty board keeps about an eighth of the moves");
+    set_cell(&a, 0, 0, CELL_X);
+    set_cell(&a, last, last, CELL_O);
+    n = unique_moves(&a, moves, gen_moves(&a, moves));
+    ASSERT(n < CELL_COUNT - 2, "Diagonal mirror still prunes moves");
+    set_cell(&a, 1, 0, CELL_O);
+    int all = gen_moves(&a, moves);
+    n = unique_moves(&a, moves, all);
+    ASSERT(n == all, "Lopsided position keeps every move");
+}
+
+void test_transposition_table() {
+    TEST("Transposition Table");
+    trans_table tt = {0};
+    int score, move;
+    
+    ASSERT(tt_init(&tt, 1), "1 MB table allocated");
+    ASSERT(sizeof(trans_bucket) == 64, "Bucket fills one cache line");
+    ASSERT(((tt.mask + 1) & tt.mask) == 0, "Bucket count is a power of two");
+    ASSERT(((uintptr_t)tt.buckets & 63) == 0, "Table is cache line aligned");
+    
+    store_trans_table(&tt, 0x1234ULL, 1, 4, 0, BOUND_EXACT, 5);
+    ASSERT(lookup_trans_table(&tt, 0x1234ULL, 4, 0, MIN_INF, MAX_INF, &score, &move) && score == 1,
+           "Exact entry returns its score");
+    ASSERT(!lookup_trans_table(&tt, 0x1234ULL, 5, 0, MIN_INF, MAX_INF, &score, &move) && move == 5,
+           "Shallow entry only gives a move hint");
+    
+    store_trans_table(&tt, 0x5678ULL, 0, 4, 0, BOUND_LOWER, -1);
+    ASSERT(lookup_trans_table(&tt, 0x5678ULL, 4, 0, -1, 0, &score, &move), "Lower bound cuts at beta");
+    ASSERT(!lookup_trans_table(&tt, 0x5678ULL, 4, 0, -1, 1, &score, &move), "Lower bound below beta is no cutoff");
+    ASSERT(move == -1, "Entry without a best move gives no hint");
+    
+    /* fill one bucket past capacity, the deepest entry must survive */
+    uint64_t base = 0x9000ULL * (tt.mask + 1);
+    store_trans_table(&tt, base, 1, 9, 0, BOUND_EXACT, 0);
+    for (int i = 1; i <= TT_BUCKET_SIZE; i++)
+        store_trans_table(&tt, base + (uint64_t)i * (tt.mask + 1), 0, 1, 0, BOUND_EXACT, 0);
+    ASSERT(lookup_trans_table(&tt, base, 9, 0, MIN_INF, MAX_INF, &score, &move), "Deep entry is not replaced");
+    
+    /* half of a racing write: data changed but the key word did not */
+    trans_entry * e = &tt.buckets[0x1234ULL & tt.mask].entry[0];
+    e->data ^= 1;
+    ASSERT(!lookup_trans_table(&tt, 0x1234ULL, 4, 0, MIN_INF, MAX_INF, &score, &move) && move == -1,
+           "Torn entry fails to verify");
+    
+    /* a win 5 moves from the root, stored 3 moves in, read back 1 move in */
+    store_trans_table(&tt, 0x4321ULL, SCORE_X - 5, 2, 3, BOUND_EXACT, 0);
+    ASSERT(lookup_trans_table(&tt, 0x4321ULL, 2, 1, MIN_INF, MAX_INF, &score, &move) && score == SCORE_X - 3,
+           "Win distance follows the position");
+    
+    clear_trans_table(&tt);
+    ASSERT(!lookup_trans_table(&tt, 0x1234ULL, 0, 0, MIN_INF, MAX_INF, &score, &move), "Clear empties the table");
+    tt_free(&tt);
+}
+
+void test_incremental_win_detection() {
+    TEST("Incremental Win Detection");
+    game_board test_board;
+    int agree = 1, counts_ok = 1;
+    
+    srand(12345);
+    for (int game = 0; game < 200; game++) {
+        init_board(&test_board);
+        char piece = (game & 1) ? CELL_X : CELL_O;
+        int moves[CELL_COUNT], n;
+        while ((n = gen_moves(&test_board, moves)) > 0) {
+            int sq = moves[rand() % n];
+            set_cell(&test_board, sq % BOARD_SIZE, sq / BOARD_SIZE, piece);
+            int full = evaluate(&test_board);
+            int last = evaluate_move(&test_board, sq % BOARD_SIZE, sq / BOARD_SIZE);
+            if (full != last) agree = 0;
+            if (full != SCORE_TIE) break;
+            piece = (piece == CELL_X) ? CELL_O : CELL_X;
+        }
+        for (int l = 0; l < LINE_COUNT; l++)
+            if (test_board.count[0][l] != bit_count(test_board.x & line_masks[l])
+             || test_board.count[1][l] != bit_count(test_board.o & line_masks[l]))
+                counts_ok = 0;
+    }
+    ASSERT(agree, "Last-move check agrees with the full board check");
+    ASSERT(counts_ok, "Line counters match the board");
+    
+    init_board(&test_board);
+    ASSERT(evaluate_move(&test_board, 0, 0) == SCORE_TIE, "Empty cell never wins");
+}
+
+void test_heuristic() {
+    TEST("Heuristic Evaluation");
+    game_board test_board;
+    int same = 1, sum;
+    
+    srand(54321);
+    for (int game = 0; game < 200; game++) {
+        init_board(&test_board);
+        char piece = (game & 1) ? CELL_X : CELL_O;
+        int moves[CELL_COUNT], n;
+        while ((n = gen_moves(&test_board, moves)) > 0 && evaluate(&test_board) == SCORE_TIE) {
+            int sq = moves[rand() % n];
+            set_cell(&test_board, sq % BOARD_SIZE, sq / BOARD_SIZE, piece);
+            if (n > 1 && rand() % 4 == 0)   /* take some moves back */
+                set_cell(&test_board, sq % BOARD_SIZE, sq / BOARD_SIZE, CELL_E);
+            else
+                piece = (piece == CELL_X) ? CELL_O : CELL_X;
+            sum = 0;
+            for (int l = 0; l < LINE_COUNT; l++)
+                sum += line_score[test_board.count[0][l]][test_board.count[1][l]];
+            if (sum != test_board.heuristic) same = 0;
+        }
+    }
+    ASSERT(same, "Incremental score matches a full recount");
+    
+    init_board(&test_board);
+    ASSERT(test_board.heuristic == 0, "Empty board is even");
+    set_cell(&test_board, 0, 0, CELL_X);
+    ASSERT(test_board.heuristic > 0, "A piece on open lines favors its side");
+    set_cell(&test_board, 1, 0, CELL_X);
+    int two = test_board.heuristic;
+    set_cell(&test_board, 2, 1, CELL_O);
+    set_cell(&test_board, 2, 2, CELL_O);
+    ASSERT(two > 0 && test_board.heuristic < two, "Opposing pieces count against");
+    ASSERT(line_score[2][1] == 0, "Blocked line is worth nothing");
+    ASSERT(LINE_COUNT * line_score[WIN_LENGTH - 1][0] < SCORE_MATE, "Guesses stay below sure wins");
+    ASSERT(win_score(CELL_X, 3) > win_score(CELL_X, 5) && win_score(CELL_O, 3) < win_score(CELL_O, 5),
+           "Sooner wins score higher");
+}
+
+void test_threat_search() {
+    TEST("Threat Space Search");
+    game_board b;
+    int sq, n = BOARD_SIZE;
+    
+    init_board(&b);
+    ASSERT(bit_count(grow((bitmask)1 << (n + 1))) == 9 && bit_count(grow(1)) == 4,
+           "Neighbors stop at the edges");
+    ASSERT(win_cells(&b, 0) == 0 && vcf_move(&b, CELL_X) == -1, "No threats on an empty board");
+    
+    /* a row and a column both one piece short of a four through the corner */
+    for (int i = 1; i < WIN_LENGTH - 1; i++) {
+        set_cell(&b, i, 0, CELL_X);
+        set_cell(&b, 0, i, CELL_X);
+    }
+    set_cell(&b, n - 1, n - 1, CELL_O);
+    ASSERT(vcf_move(&b, CELL_X) == 0, "Double four through the corner is found");
+    ASSERT(win_cells(&b, 1) == 0, "Defender has no four of its own");
+    
+    place(&b, 0, CELL_X);
+    ASSERT(bit_count(win_cells(&b, 0)) == 2, "Two winning cells are open");
+    unplace(&b, 0, CELL_X);
+    
+    /* O is one piece short on the last row: X must block or win at once */
+    for (int i = 1; i < WIN_LENGTH; i++) set_cell(&b, n - i, n - 1, CELL_O);
+    int block = n - WIN_LENGTH + (n - 1) * n;
+    sq = vcf_move(&b, CELL_X);
+    ASSERT(sq == -1 || sq == block, "Attack starts by blocking a four");
+}
+
+void test_proof_number() {
+    TEST("Proof-Number Search");
+    pns_ctx p;
+    game_board b;
+    int sq, result;
+    
+    ASSERT(pns_init(&p, 1 << 16), "Proof trees are allocated");
+    init_board(&b);
+    for (int c = 0; c < WIN_LENGTH - 1; c++) {  /* X is one short of a row */
+        set_cell(&b, c, 1, CELL_X);
+        if (c < WIN_LENGTH - 2) set_cell(&b, c, 0, CELL_O);
+    }
+    set_cell(&b, BOARD_SIZE - 1, BOARD_SIZE - 1, CELL_O);
+    ASSERT(pns_prove(&p, &b, CELL_X, CELL_X, &sq) == PNS_PROVEN && sq == WIN_LENGTH - 1 + BOARD_SIZE,
+           "Win in one is proven with its move");
+    ASSERT(pns_prove(&p, &b, CELL_O, CELL_X, &sq) == PNS_DISPROVEN, "Defender has no forced win");
+    ASSERT(p.outer.used <= p.outer.size && p.inner.used <= p.inner.size, "Trees stay within the cap");
+#if BOARD_SIZE == 3
+    solver_ctx solver;
+    bool agrees = true;
+    
+    /* every position with X to move against the solved values */
+    solver_init(&solver, 1);
+    solver_run(&solver);
+    for (uint32_t code = 0; code < solver.codes; code++) {
+        int value = db_get(solver.values, code);
+        if (value == DB_NONE) continue;
+        init_board(&b);
+        for (uint32_t i = 0, c = code; i < CELL_COUNT; i++, c /= 3)
+            if (c % 3) place(&b, i, c % 3 == 1 ? CELL_X : CELL_O);
+        if ((pns_prove(&p, &b, CELL_X, CELL_X, &sq) == PNS_PROVEN) != (value == DB_WIN)) agrees = false;
+        if ((pns_prove(&p, &b, CELL_O, CELL_X, &sq) == PNS_PROVEN) != (value == DB_LOSS)) agrees = false;
+    }
+    solver_free(&solver);
+    ASSERT(agrees, "Proofs match the retrograde solver");
+    
+    init_board(&b);
+    result = pns_prove(&p, &b, CELL_X, CELL_X, &sq);
+    ASSERT(result == PNS_DISPROVEN && p.expanded > 0, "Empty board is no forced win");
+    
+    new_game(&ctx);
+    set_cell(&ctx.board, 0, 0, CELL_X);     /* two X lines open at once */
+    set_cell(&ctx.board, 1, 0, CELL_O);
+    set_cell(&ctx.board, 2, 0, CELL_X);
+    set_cell(&ctx.board, 0, 2, CELL_O);
+    set_cell(&ctx.board, 2, 2, CELL_X);
+    ctx.current = CELL_O;
+    ASSERT(pns_lost(&ctx) == PNS_PROVEN, "Human is told a lost position is lost");
+    
+    new_game(&ctx);
+    set_cell(&ctx.board, 2, 2, CELL_X);
+    set_cell(&ctx.board, 0, 0, CELL_O);
+    set_cell(&ctx.board, 2, 0, CELL_X);
+    set_cell(&ctx.board, 1, 1, CELL_O);
+    ctx.move_count = 4;
+    engine_use(&ctx, engine_find("PN2"));
+    ctx.book = false;
+    computer_move(&ctx);
+    ASSERT(evaluate(&ctx.board) == SCORE_X && ctx.states > 0, "Proof mode plays the proven win");
+    
+    new_game(&ctx);                         /* only a draw is left for X */
+    set_cell(&ctx.board, 0, 0, CELL_X);
+    set_cell(&ctx.board, 1, 1, CELL_O);
+    set_cell(&ctx.board, 2, 2, CELL_X);
+    set_cell(&ctx.board, 0, 1, CELL_O);
+    ctx.move_count = 4;
+    computer_move(&ctx);
+    ASSERT(get_cell(&ctx.board, 2, 1) == CELL_X, "Unproven positions fall back to minimax");
+    engine_use(&ctx, engine_find("PVS"));
+    ctx.book = true;
+#endif
+    pns_free(&p);
+    
+    /* a cap too small for the empty board leaves it open */
+    ASSERT(pns_init(&p, 16), "Tiny trees are allocated");
+    init_board(&b);
+    result = pns_prove(&p, &b, CELL_X, CELL_X, &sq);
+    ASSERT(result == PNS_UNKNOWN || CELL_COUNT < 16, "Node cap stops the search");
+    pns_free(&p);
 }
 
 void test_win_detection_rows() {
@@ -55,23 +390,23 @@ void test_win_detection_rows() {
     game_board test_board;
     
     for (int r = 0; r < BOARD_SIZE; r++) {
-        init_board(test_board);
+        init_board(&test_board);
         for (int c = 0; c < BOARD_SIZE; c++)
-            test_board[r][c] = CELL_X;
+            set_cell(&test_board, c, r, CELL_X);
         
         char msg[64];
         sprintf(msg, "X wins on row %d", r);
-        ASSERT(evaluate(test_board) == SCORE_X, msg);
+        ASSERT(evaluate(&test_board) == SCORE_X, msg);
     }
     
     for (int r = 0; r < BOARD_SIZE; r++) {
-        init_board(test_board);
+        init_board(&test_board);
         for (int c = 0; c < BOARD_SIZE; c++)
-            test_board[r][c] = CELL_O;
+            set_cell(&test_board, c, r, CELL_O);
         
         char msg[64];
         sprintf(msg, "O wins on row %d", r);
-        ASSERT(evaluate(test_board) == SCORE_O, msg);
+        ASSERT(evaluate(&test_board) == SCORE_O, msg);
     }
 }
 
@@ -80,23 +415,23 @@ void test_win_detection_columns() {
     game_board test_board;
     
     for (int c = 0; c < BOARD_SIZE; c++) {
-        init_board(test_board);
+        init_board(&test_board);
         for (int r = 0; r < BOARD_SIZE; r++)
-            test_board[r][c] = CELL_X;
+            set_cell(&test_board, c, r, CELL_X);
         
         char msg[64];
         sprintf(msg, "X wins on column %d", c);
-        ASSERT(evaluate(test_board) == SCORE_X, msg);
+        ASSERT(evaluate(&test_board) == SCORE_X, msg);
     }
     
     for (int c = 0; c < BOARD_SIZE; c++) {
-        init_board(test_board);
+        init_board(&test_board);
         for (int r = 0; r < BOARD_SIZE; r++)
-            test_board[r][c] = CELL_O;
+            set_cell(&test_board, c, r, CELL_O);
         
         char msg[64];
         sprintf(msg, "O wins on column %d", c);
-        ASSERT(evaluate(test_board) == SCORE_O, msg);
+        ASSERT(evaluate(&test_board) == SCORE_O, msg);
     }
 }
 
@@ -105,42 +440,41 @@ void test_win_detection_diagonals() {
     game_board test_board;
     
     // Primary diagonal (top-left to bottom-right)
-    init_board(test_board);
+    init_board(&test_board);
     for (int i = 0; i < BOARD_SIZE; i++)
-        test_board[i][i] = CELL_X;
-    ASSERT(evaluate(test_board) == SCORE_X, "X wins on primary diagonal");
+        set_cell(&test_board, i, i, CELL_X);
+    ASSERT(evaluate(&test_board) == SCORE_X, "X wins on primary diagonal");
     
-    init_board(test_board);
+    init_board(&test_board);
     for (int i = 0; i < BOARD_SIZE; i++)
-        test_board[i][i] = CELL_O;
-    ASSERT(evaluate(test_board) == SCORE_O, "O wins on primary diagonal");
+        set_cell(&test_board, i, i, CELL_O);
+    ASSERT(evaluate(&test_board) == SCORE_O, "O wins on primary diagonal");
     
     // Secondary diagonal (top-right to bottom-left)
-    init_board(test_board);
+    init_board(&test_board);
     for (int i = 0; i < BOARD_SIZE; i++)
-        test_board[i][BOARD_SIZE-1-i] = CELL_X;
-    ASSERT(evaluate(test_board) == SCORE_X, "X wins on secondary diagonal");
+        set_cell(&test_board, BOARD_SIZE-1-i, i, CELL_X);
+    ASSERT(evaluate(&test_board) == SCORE_X, "X wins on secondary diagonal");
     
-    init_board(test_board);
+    init_board(&test_board);
     for (int i = 0; i < BOARD_SIZE; i++)
-        test_board[i][BOARD_SIZE-1-i] = CELL_O;
-    ASSERT(evaluate(test_board) == SCORE_O, "O wins on secondary diagonal");
+        set_cell(&test_board, BOARD_SIZE-1-i, i, CELL_O);
+    ASSERT(evaluate(&test_board) == SCORE_O, "O wins on secondary diagonal");
 }
 
 void test_tie_detection() {
     TEST("Tie Detection");
     game_board test_board;
-    init_board(test_board);
+    init_board(&test_board);
     
     // Create a tied board (3x3 example)
     if (BOARD_SIZE == 3) {
-        test_board[0][0] = CELL_X; test_board[0][1] = CELL_O; test_board[0][2] = CELL_X;
-        test_board[1][0] = CELL_X; test_board[1][1] = CELL_O; test_board[1][2] = CELL_O;
-        test_board[2][0] = CELL_O; test_board[2][1] = CELL_X; test_board[2][2] = CELL_X;
-        move_count = 9;  /* Update move count for full board */
+        set_cell(&test_board, 0, 0, CELL_X); set_cell(&test_board, 1, 0, CELL_O); set_cell(&test_board, 2, 0, CELL_X);
+        set_cell(&test_board, 0, 1, CELL_X); set_cell(&test_board, 1, 1, CELL_O); set_cell(&test_board, 2, 1, CELL_O);
+        set_cell(&test_board, 0, 2, CELL_O); set_cell(&test_board, 1, 2, CELL_X); set_cell(&test_board, 2, 2, CELL_X);
         
-        ASSERT(evaluate(test_board) == SCORE_TIE, "Tied game detected correctly");
-        ASSERT(!has_move(test_board), "No moves left on full board");
+        ASSERT(evaluate(&test_board) == SCORE_TIE, "Tied game detected correctly");
+        ASSERT(!has_move(&test_board), "No moves left on full board");
     } else {
         printf("  (Skipped - only for 3x3 board)\n");
     }
@@ -148,42 +482,40 @@ void test_tie_detection() {
 
 void test_human_move() {
     TEST("Human Move Validation");
-    game_board test_board;
-    init_board(test_board);
+    new_game(&ctx);
     
-    human = CELL_O;
-    computer = CELL_X;
-    current = human;
+    ctx.human = CELL_O;
+    ctx.computer = CELL_X;
+    ctx.current = ctx.human;
     
-    ASSERT(human_move(test_board, 0, 0), "Valid move accepted");
-    ASSERT(test_board[0][0] == CELL_O, "Cell marked correctly");
-    ASSERT(current == computer, "Turn switched to computer");
+    ASSERT(human_move(&ctx, 0, 0), "Valid move accepted");
+    ASSERT(get_cell(&ctx.board, 0, 0) == CELL_O, "Cell marked correctly");
+    ASSERT(ctx.current == ctx.computer, "Turn switched to computer");
     
-    current = human;
-    ASSERT(!human_move(test_board, 0, 0), "Occupied cell rejected");
+    ctx.current = ctx.human;
+    ASSERT(!human_move(&ctx, 0, 0), "Occupied cell rejected");
 }
 
 void test_computer_move() {
     TEST("Computer Move Validation");
-    game_board test_board;
-    init_board(test_board);
+    new_game(&ctx);
     
-    human = CELL_O;
-    computer = CELL_X;
-    current = computer;
-    game_depth = GAME_MEDIUM;
+    ctx.human = CELL_O;
+    ctx.computer = CELL_X;
+    ctx.current = ctx.computer;
+    ctx.game_depth = GAME_MEDIUM;
     
     srand((unsigned int)time(NULL));
     
-    computer_move(test_board);
+    computer_move(&ctx);
     
     int computer_moves = 0;
     for (int r = 0; r < BOARD_SIZE; r++)
         for (int c = 0; c < BOARD_SIZE; c++)
-            if (test_board[r][c] == CELL_X) computer_moves++;
+            if (get_cell(&ctx.board, c, r) == CELL_X) computer_moves++;
     
     ASSERT(computer_moves == 1, "Computer made exactly one move");
-    ASSERT(current == human, "Turn switched to human");
+    ASSERT(ctx.current == ctx.human, "Turn switched to human");
 }
 
 void test_ai_blocking() {
@@ -193,23 +525,22 @@ void test_ai_blocking() {
         return;
     }
     
-    game_board test_board;
-    init_board(test_board);
+    new_game(&ctx);
     
-    human = CELL_O;
-    computer = CELL_X;
-    game_depth = GAME_IMPOSSIBLE;
+    ctx.human = CELL_O;
+    ctx.computer = CELL_X;
+    ctx.game_depth = GAME_IMPOSSIBLE;
     
     // Set up board where blocking is critical
-    test_board[0][0] = CELL_O;
-    test_board[0][1] = CELL_O;
-    test_board[1][1] = CELL_X;  /* AI has center */
-    move_count = 3;
+    set_cell(&ctx.board, 0, 0, CELL_O);
+    set_cell(&ctx.board, 1, 0, CELL_O);
+    set_cell(&ctx.board, 1, 1, CELL_X);  /* AI has center */
+    ctx.move_count = 3;
     
-    computer_move(test_board);
+    computer_move(&ctx);
     
     // Verify AI blocked the winning move
-    ASSERT(test_board[0][2] == CELL_X, "AI blocks human's winning move");
+    ASSERT(get_cell(&ctx.board, 2, 0) == CELL_X, "AI blocks human's winning move");
 }
 
 void test_ai_winning() {
@@ -219,21 +550,20 @@ void test_ai_winning() {
         return;
     }
     
-    game_board test_board;
-    init_board(test_board);
+    new_game(&ctx);
     
-    human = CELL_O;
-    computer = CELL_X;
-    game_depth = GAME_IMPOSSIBLE;  // Use max depth for this test
+    ctx.human = CELL_O;
+    ctx.computer = CELL_X;
+    ctx.game_depth = GAME_IMPOSSIBLE;  // Use max depth for this test
     
     // Computer has two in a row, should win on this turn
-    test_board[1][0] = CELL_X;
-    test_board[1][1] = CELL_X;
-    move_count = 2;  /* Update move count for manual setup */
+    set_cell(&ctx.board, 0, 1, CELL_X);
+    set_cell(&ctx.board, 1, 1, CELL_X);
+    ctx.move_count = 2;  /* Update move count for manual setup */
     
-    computer_move(test_board);
+    computer_move(&ctx);
     
-    int result = evaluate(test_board);
+    int result = evaluate(&ctx.board);
     
     // AI should either win immediately or make a winning position
     ASSERT(result == SCORE_X || result == SCORE_TIE, "AI wins or maintains advantage");
@@ -242,43 +572,736 @@ void test_ai_winning() {
     int x_count = 0;
     for (int r = 0; r < BOARD_SIZE; r++)
         for (int c = 0; c < BOARD_SIZE; c++)
-            if (test_board[r][c] == CELL_X) x_count++;
+            if (get_cell(&ctx.board, c, r) == CELL_X) x_count++;
     ASSERT(x_count == 3, "AI made exactly one move (3 X's total)");
 }
 
+void test_computer_as_o() {
+    TEST("Computer Playing O");
+    int score, sq;
+    
+    /* O one short of a row, X one piece ahead */
+    new_game(&ctx);
+    ctx.computer = CELL_O;
+    ctx.human = CELL_X;
+    for (int c = 0; c < WIN_LENGTH - 1; c++) {
+        set_cell(&ctx.board, c, 1, CELL_O);
+        if (c < WIN_LENGTH - 2) set_cell(&ctx.board, c, 0, CELL_X);
+    }
+    set_cell(&ctx.board, BOARD_SIZE - 1, BOARD_SIZE - 1, CELL_X);
+    ctx.move_count = 2 * WIN_LENGTH - 2;
+    sq = select_move(&ctx, &score);
+    ASSERT(sq == BOARD_SIZE + WIN_LENGTH - 1 && score > 0 && score_decided(score), "O takes its win, scored for O");
+    computer_move(&ctx);
+    ASSERT(evaluate(&ctx.board) == SCORE_O, "Computer move places an O");
+    
+#if BOARD_SIZE == 3
+    /* both sides searched in turn from the empty board: a draw */
+    engine_ctx side[2];
+    char mover = CELL_O;
+    
+    engine_init(&side[0], 1);
+    engine_init(&side[1], 1);
+    init_board(&ctx.board);
+    while (has_move(&ctx.board) && evaluate(&ctx.board) == SCORE_TIE) {
+        engine_ctx * e = &side[mover == CELL_X];
+        e->board = ctx.board;
+        e->computer = mover;
+        e->human = mover == CELL_X ? CELL_O : CELL_X;
+        e->game_depth = CELL_COUNT;
+        e->book = false;
+        place(&ctx.board, select_move(e, &score), mover);
+        mover = e->human;
+    }
+    ASSERT(evaluate(&ctx.board) == SCORE_TIE && !has_move(&ctx.board), "Perfect play from both sides draws");
+    engine_free(&side[0]);
+    engine_free(&side[1]);
+#endif
+    ctx.computer = CELL_X;
+    ctx.human = CELL_O;
+}
+
+void test_move_ordering() {
+    TEST("Dynamic Move Ordering");
+    int moves[CELL_COUNT], n, last = CELL_COUNT - 1, ahead = 0, twin = 0;
+    int hint = move_order[last], killer = move_order[last - 1];
+    
+    /* the last cell alike to the second one, and the cells of earlier groups */
+    for (int i = 0; i < CELL_COUNT; i++) {
+        if (order_class[move_order[i]] == order_class[move_order[1]]) twin = move_order[i];
+        if (order_class[move_order[i]] < order_class[move_order[1]]) ahead++;
+    }
+    
+    new_game(&ctx);
+    order_reset(&ctx);
+    memset(ctx.history, 0, sizeof(ctx.history));
+    n = gen_moves(&ctx.board, moves);
+    order_moves(&ctx, moves, n, -1, 0, true);
+    ASSERT(moves[0] == move_order[0] && moves[last] == move_order[last], "No knowledge keeps the static order");
+    
+    note_cutoff(&ctx, 0, true, killer);
+    ctx.history[1][twin] = 8;
+    n = gen_moves(&ctx.board, moves);
+    order_moves(&ctx, moves, n, hint, 0, true);
+    ASSERT(moves[0] == hint, "Table move goes first");
+    ASSERT(moves[1] == killer, "Killer of the ply comes next");
+    ASSERT(moves[2 + ahead] == twin, "History only reorders alike cells");
+    
+    n = gen_moves(&ctx.board, moves);
+    order_moves(&ctx, moves, n, -1, 1, false);
+    ASSERT(moves[0] == move_order[0], "Killers and history stay with their ply and side");
+    order_reset(&ctx);
+}
+
+void test_pvs() {
+    TEST("Principal Variation Search");
+    engine_ctx pvs, ab;
+    long pvs_nodes = 0, ab_nodes = 0;
+    bool same = true;
+    
+    ASSERT(engine_init(&pvs, 1) && engine_init(&ab, 1), "PVS and alpha-beta contexts ready");
+    ASSERT(engine_use(&ab, engine_find("ABPRUNE")) && strcmp(engine_name(&pvs), engine_name(&ab)) != 0,
+           "Algorithms are told apart");
+    
+    /* both sides play the engine's choice from every opening */
+    for (int open = 0; open < CELL_COUNT; open++) {
+        new_game(&pvs);
+        new_game(&ab);
+        pvs.game_depth = ab.game_depth = GAME_HARD;
+        human_move(&pvs, open % BOARD_SIZE, open / BOARD_SIZE);
+        human_move(&ab, open % BOARD_SIZE, open / BOARD_SIZE);
+        computer_move(&pvs);
+        computer_move(&ab);
+        pvs_nodes += pvs.states;
+        ab_nodes += ab.states;
+        if (pvs.board.x != ab.board.x) same = false;
+    }
+    printf("  Nodes: %s %ld, %s %ld\n", engine_name(&ab), ab_nodes, engine_name(&pvs), pvs_nodes);
+    ASSERT(same, "PVS picks the same replies as alpha-beta");
+    ASSERT(pvs.tt_probes > 0 && pvs.tt_hits > 0 && pvs.tt_hits <= pvs.tt_probes, "Table lookups and hits are counted");
+    
+    /* plain minimax switched to at run time */
+    long plain_nodes = 0;
+    pvs_nodes = 0;
+    ASSERT(engine_use(&ab, engine_find("MINIMAX")) && !ab.prune, "Unpruned search is plain minimax");
+    for (int open = 0; open < CELL_COUNT; open += 1 + CELL_COUNT / 10) {
+        new_game(&ab);
+        new_game(&pvs);
+        human_move(&ab, open % BOARD_SIZE, open / BOARD_SIZE);
+        human_move(&pvs, open % BOARD_SIZE, open / BOARD_SIZE);
+        computer_move(&ab);
+        computer_move(&pvs);
+        plain_nodes += ab.states;
+        pvs_nodes += pvs.states;
+        if (pvs.board.x != ab.board.x) same = false;
+    }
+    printf("  Nodes: MINIMAX %ld, PVS %ld\n", plain_nodes, pvs_nodes);
+    ASSERT(same && plain_nodes > pvs_nodes, "Pruning saves nodes, not moves");
+    
+    engine_free(&pvs);
+    engine_free(&ab);
+}
+
+void test_timed_search() {
+    TEST("Timed Iterative Deepening");
+    new_game(&ctx);
+    ctx.game_depth = CELL_COUNT;        /* only the clock limits the search */
+    ctx.time_budget = 5;
+    ctx.book = false;
+    
+    int64_t start = clock_ms();
+    computer_move(&ctx);
+    ASSERT(clock_ms() - start < 250, "Move comes back close to its budget");
+    ASSERT(bit_count(ctx.board.x) == 1 && ctx.board.o == 0, "Timed search makes one legal move");
+    ASSERT(ctx.stop == NULL && ctx.deadline == 0, "Search leaves no deadline behind");
+    
+    /* one row away from a win: the first iteration already sees it */
+    new_game(&ctx);
+    ctx.time_budget = 200;
+    for (int c = 0; c < WIN_LENGTH - 1; c++) {
+        set_cell(&ctx.board, c, 1, CELL_X);
+        if (c < WIN_LENGTH - 2) set_cell(&ctx.board, c, 0, CELL_O);
+    }
+    set_cell(&ctx.board, BOARD_SIZE - 1, BOARD_SIZE - 1, CELL_O);
+    ctx.move_count = 2 * WIN_LENGTH - 2;
+    computer_move(&ctx);
+    ASSERT(evaluate(&ctx.board) == SCORE_X, "Timed search takes the win");
+#if !K_IN_A_ROW                         /* else the threat search takes it */
+    ASSERT(ctx.live.depth == 1, "Decided positions stop deepening");
+#endif
+    
+    ctx.time_budget = 0;
+    ctx.game_depth = GAME_IMPOSSIBLE;
+    ctx.book = true;
+}
+
+/* an engine from outside the tree: the first move it is offered */
+int first_move(engine_ctx * c, int * moves, int n, int * score) {
+    (void)c;
+    (void)n;
+    *score = SCORE_UNKNOWN;
+    return moves[0];
+}
+
+const search_engine engine_first = {
+    "FIRST", "the first move offered",
+    init_alphabeta, first_move, halt_search, report_search, free_none
+};
+
+void * select_worker(void * arg) {
+    int score;
+    select_move((engine_ctx *)arg, &score);
+    return NULL;
+}
+
+void test_search_engines() {
+    TEST("Pluggable Search Engines");
+    engine_ctx e;
+    search_report r;
+    thread_t tid;
+    int moves[CELL_COUNT], n, open = CELL_COUNT / 2;
+    int64_t start;
+    bool named = true, played = true;
+    
+    ASSERT(engine_init(&e, 1) && !strcmp(engine_name(&e), "PVS"), "PVS is the default engine");
+    for (int i = 0; i < engine_count(); i++)
+        if (engine_find(engine_at(i)->name) != engine_at(i)) named = false;
+    ASSERT(named && engine_count() >= 5 && engine_find("abprune") == engine_find("ABPRUNE"),
+           "Engines are found by name, any case");
+    ASSERT(!engine_find("NONE") && !engine_use(&e, NULL) && !strcmp(engine_name(&e), "PVS"),
+           "An unknown engine leaves the context alone");
+    ASSERT(engine_register(&engine_first) && !engine_register(&engine_first), "An engine registers once");
+    
+    /* every engine in turn on the same context, one move each */
+    e.book = false;
+    e.game_depth = GAME_HARD;
+    e.playouts = 500;
+    for (int i = 0; i < engine_count(); i++) {
+        new_game(&e);
+        human_move(&e, open % BOARD_SIZE, open / BOARD_SIZE);
+        engine_use(&e, engine_at(i));
+        computer_move(&e);
+        engine_report(&e, &r);
+        if (bit_count(e.board.x) != 1 || r.nodes != e.states) played = false;
+    }
+    ASSERT(played, "Each engine plays a move of the same game and reports it");
+    
+    new_game(&e);
+    human_move(&e, open % BOARD_SIZE, open / BOARD_SIZE);
+    n = unique_moves(&e.board, moves, gen_moves(&e.board, moves));
+    engine_use(&e, engine_find("FIRST"));
+    computer_move(&e);
+    ASSERT(n < 2 || bit_scan(e.board.x) == moves[0], "A registered engine picks the move");
+    
+    engine_use(&e, engine_find("MCTS"));
+    new_game(&e);
+    computer_move(&e);
+    ASSERT(e.mcts != NULL, "MCTS keeps a tree");
+    engine_use(&e, engine_find("PVS"));
+    ASSERT(e.mcts == NULL && e.prune && e.pvs, "Switching engines frees it and sets the new one up");
+    
+    /* a long search stopped from another thread */
+    engine_use(&e, engine_find("MCTS"));
+    new_game(&e);
+    e.game_depth = CELL_COUNT;
+    e.time_budget = 60000;
+    atomic_put(&e.live.nodes, 0);       /* raised again once it runs */
+    start = clock_ms();
+    ASSERT(thread_start(&tid, select_worker, &e), "A minute long search starts");
+    while (atomic_get(&e.live.nodes) == 0 && clock_ms() - start < 5000);
+    engine_stop(&e);
+    thread_join(tid);
+    ASSERT(clock_ms() - start < 5000 && atomic_get(&e.live.best) >= 0,
+           "Stopping it early still gives a move");
+    
+    engine_stop(&e);                    /* before the search has started */
+    start = clock_ms();
+    ASSERT(thread_start(&tid, select_worker, &e), "Another one starts after a stop");
+    thread_join(tid);
+    ASSERT(clock_ms() - start < 5000 && !e.halt, "An early stop is kept for it and spent");
+    engine_free(&e);
+}
+
+void test_search_stats() {
+    TEST("Search Statistics");
+#ifdef _USE_SEARCH_STATS_
+    search_stats * s = &ctx.stats;
+    char line[8192];
+    int64_t nodes = 0, leaves = 0, cutoffs = 0, first = 0, iterated = 0;
+    int rows = 0, plies = 0;
+    bool deeper = true;
+    FILE * f;
+    
+    new_game(&ctx);
+    ctx.game_depth = GAME_HARD;
+    ctx.book = false;
+    human_move(&ctx, 0, 0);
+    computer_move(&ctx);
+    for (int p = 0; p < STATS_PLIES; p++) {
+        if (p > 0) nodes += s->nodes[p];
+        leaves += s->leaves[p];
+        cutoffs += s->cutoffs[p];
+        first += s->first_cutoffs[p];
+        if (s->nodes[p] || s->leaves[p]) plies = p + 1;
+    }
+    ASSERT(s->nodes[0] == 1 && nodes == ctx.states, "Nodes by ply add up to the searched states");
+    ASSERT(leaves > 0 && s->leaves[1] == 0, "Leaves are counted at the horizon");
+    ASSERT(cutoffs > 0 && first <= cutoffs, "Cutoffs and first move cutoffs are counted");
+    ASSERT(s->probes == ctx.tt_probes && s->hits == ctx.tt_hits, "Table probes and hits are taken over");
+    ASSERT(s->stores > 0 && s->overwrites <= s->stores, "Table stores and overwrites are counted");
+    ASSERT(s->iterations == 1 && s->iter_nodes[0] == ctx.states, "A fixed depth search is one iteration");
+    ASSERT(stats_branching(s) > 1.0, "Effective branching factor is worked out");
+    
+    f = tmpfile();
+    stats_dump(&ctx, f, STATS_CSV);
+    rewind(f);
+    while (fgets(line, sizeof(line), f)) rows++;
+    ASSERT(rows == 1 + plies + s->iterations, "CSV has a total, a row per ply and per iteration");
+    rewind(f);
+    stats_dump(&ctx, f, STATS_JSON);
+    rewind(f);
+    ASSERT(fgets(line, sizeof(line), f) && !strncmp(line, "{\"move\":2,", 10)
+           && strstr(line, "\"plies\":[{\"ply\":0,") && strstr(line, "]}\n"), "JSON is one object a line");
+    fclose(f);
+    
+    new_game(&ctx);
+    ctx.game_depth = CELL_COUNT;        /* only the clock limits the search */
+    ctx.time_budget = 50;
+    human_move(&ctx, 0, 0);
+    computer_move(&ctx);
+    for (int i = 0; i < s->iterations; i++) {
+        iterated += s->iter_nodes[i];
+        if (i > 0 && s->iter_depth[i] <= s->iter_depth[i-1]) deeper = false;
+    }
+    ASSERT(s->iterations >= 1 && deeper, "Every finished iteration is recorded");
+    ASSERT(iterated <= ctx.states && s->iter_us[0] <= s->us, "Iterations share out the nodes and time");
+    
+    ctx.time_budget = 0;
+    ctx.game_depth = GAME_IMPOSSIBLE;
+    ctx.book = true;
+#else
+    printf("  (Skipped - statistics compiled out)\n");
+#endif
+}
+
+void test_book() {
+    TEST("Perfect Play Table");
+#ifdef _USE_BOOK_
+    engine_ctx solver;
+    bool sorted = true, agrees = true;
+    int score, moves[CELL_COUNT], n;
+    
+    for (int i = 1; i < BOOK3_SIZE; i++)
+        if (BOOK_KEY(book3[i-1]) >= BOOK_KEY(book3[i])) sorted = false;
+    ASSERT(sorted, "Entries are sorted for the binary search");
+    
+    /* every position with X to move against a full depth search */
+    engine_init(&solver, 1);
+    solver.game_depth = solver.search_depth = CELL_COUNT;
+    for (int i = 0; i < BOOK3_SIZE; i++) {
+        if (book3[i] & 0x100) continue;         /* O to move */
+        init_board(&solver.board);
+        for (int sq = 0, c = book3[i] >> 9; sq < CELL_COUNT; sq++, c /= 3)
+            if (c % 3) place(&solver.board, sq, c % 3 == 1 ? CELL_X : CELL_O);
+        n = gen_moves(&solver.board, moves);
+        serial_root(&solver, moves, n, MIN_INF, MAX_INF, &score);
+        int value = score > 0 ? BOOK_WIN : score < 0 ? BOOK_LOSS : BOOK_DRAW;
+        if (value != BOOK_VALUE(book3[i])) agrees = false;
+    }
+    engine_free(&solver);
+    ASSERT(agrees, "Stored values match a full search");
+    
+    new_game(&ctx);
+    ASSERT(book_probe(&ctx.board, CELL_X, &score) == 4 && score == SCORE_TIE, "Empty board: center, a draw");
+    set_cell(&ctx.board, 2, 2, CELL_X);
+    set_cell(&ctx.board, 0, 0, CELL_O);
+    set_cell(&ctx.board, 2, 0, CELL_X);
+    set_cell(&ctx.board, 1, 1, CELL_O);
+    ASSERT(book_probe(&ctx.board, CELL_X, &score) == 5 && score == SCORE_X, "Winning move found through a symmetry");
+    set_cell(&ctx.board, 1, 0, CELL_X);
+    ASSERT(book_probe(&ctx.board, CELL_X, &score) == -1, "Impossible position is not in the table");
+    
+    new_game(&ctx);
+    ctx.game_depth = GAME_IMPOSSIBLE;
+    human_move(&ctx, 0, 0);
+    computer_move(&ctx);
+    ASSERT(ctx.states == 0 && get_cell(&ctx.board, 1, 1) == CELL_X, "Impossible level answers without a search");
+#else
+    printf("  (Skipped - only for 3x3 board)\n");
+#endif
+}
+
+void test_solver() {
+    TEST("Retrograde Solver");
+    solver_ctx solver;
+#if BOARD_SIZE == 3
+    engine_ctx searcher;
+    bool agrees = true;
+    int64_t total = 0;
+    int score, value, moves[CELL_COUNT], n;
+    
+    ASSERT(solver_init(&solver, 3), "Solver is set up");
+    solver_run(&solver);
+    for (int k = 0; k <= CELL_COUNT; k++) total += solver.stats[k].positions;
+    ASSERT(solver.stats[0].positions == 1 && total > 0, "Every layer is counted");
+    
+    /* every position with X to move against a full depth search */
+    engine_init(&searcher, 1);
+    searcher.game_depth = searcher.search_depth = CELL_COUNT;
+    for (uint32_t code = 0; code < solver.codes; code++) {
+        init_board(&searcher.board);
+        for (uint32_t sq = 0, c = code; sq < CELL_COUNT; sq++, c /= 3)
+            if (c % 3) place(&searcher.board, sq, c % 3 == 1 ? CELL_X : CELL_O);
+        int nx = bit_count(searcher.board.x), no = bit_count(searcher.board.o);
+        if ((no != nx && no != nx + 1) || evaluate(&searcher.board) != SCORE_TIE) value = DB_NONE;
+        else if (!has_move(&searcher.board)) value = DB_DRAW;
+        else {
+            n = gen_moves(&searcher.board, moves);
+            serial_root(&searcher, moves, n, MIN_INF, MAX_INF, &score);
+            value = score > 0 ? DB_WIN : score < 0 ? DB_LOSS : DB_DRAW;
+        }
+        if (value != db_get(solver.values, code)) agrees = false;
+    }
+    engine_free(&searcher);
+    ASSERT(agrees, "Every value matches a full search");
+    solver_free(&solver);
+#else
+    printf("  (Skipped - only for 3x3 board)\n");
+#endif
+    ASSERT(solver_init(&solver, 1) == (CELL_COUNT <= SOLVER_MAX_CELLS), "Boards up to 4x4 are solved");
+    solver_free(&solver);
+}
+
+void test_solved_db() {
+    TEST("Solved Position Database");
+    solved_db db;
+    int score;
+    
+    ASSERT(!db_open(&db, "test/missing.db"), "Missing file is not opened");
+    ASSERT(db_probe(NULL, &ctx.board, CELL_X, &score) == -1, "No database, no move");
+#if BOARD_SIZE == 3
+    const char * path = "test/tst_db.tmp";
+    solver_ctx solver;
+    
+    solver_init(&solver, 2);
+    solver_run(&solver);
+    ASSERT(solver_write(&solver, path), "Solved values are written");
+    solver_free(&solver);
+    ASSERT(db_open(&db, path), "Database file is opened");
+    new_game(&ctx);
+    ASSERT(db_probe(&db, &ctx.board, CELL_X, &score) >= 0 && score == SCORE_TIE, "Empty board is a draw");
+    set_cell(&ctx.board, 2, 2, CELL_X);
+    set_cell(&ctx.board, 0, 0, CELL_O);
+    set_cell(&ctx.board, 2, 0, CELL_X);
+    set_cell(&ctx.board, 1, 1, CELL_O);
+    ASSERT(db_probe(&db, &ctx.board, CELL_X, &score) == 5 && score == SCORE_X, "Winning move is found");
+    unplace(&ctx.board, 8, CELL_X);     /* O to move, colors swapped */
+    set_cell(&ctx.board, 0, 2, CELL_X);
+    set_cell(&ctx.board, 1, 0, CELL_X);
+    ASSERT(db_probe(&db, &ctx.board, CELL_O, &score) == 8 && score == SCORE_O, "O wins the same way");
+    set_cell(&ctx.board, 1, 2, CELL_X);
+    ASSERT(db_probe(&db, &ctx.board, CELL_O, &score) == -1, "Impossible position is not looked up");
+    db_close(&db);
+    remove(path);
+#else
+    printf("  (Skipped - only for 3x3 board)\n");
+#endif
+}
+
+void test_independent_contexts() {
+    TEST("Independent Engine Contexts");
+    engine_ctx a, b;
+    
+    ASSERT(engine_init(&a, 1) && engine_init(&b, 1), "Two contexts with their own tables");
+    a.game_depth = GAME_IMPOSSIBLE;
+    b.game_depth = GAME_MEDIUM;
+    
+    human_move(&a, 0, 0);
+    computer_move(&a);
+    ASSERT(b.board.x == 0 && b.board.o == 0 && b.move_count == 0, "Moves in one game leave the other alone");
+    
+    human_move(&b, BOARD_SIZE - 1, BOARD_SIZE - 1);
+    computer_move(&b);
+    ASSERT(a.move_count == 2 && b.move_count == 2, "Each context counts its own moves");
+    ASSERT(a.tt != b.tt, "Contexts do not share a table by default");
+    
+    engine_free(&a);
+    engine_free(&b);
+}
+
+void test_parallel_search(int mode) {
+    TEST(mode == SMP_SPLIT ? "Parallel Root Search" : "Lazy SMP Search");
+    engine_ctx serial, split;
+    int openings[3] = { 0, CELL_COUNT / 2, BOARD_SIZE - 1 };
+    bool same = true;
+    
+    ASSERT(engine_init(&serial, 1) && engine_init(&split, 1), "Serial and parallel contexts ready");
+    ASSERT(engine_set_threads(&split, 4) && split.threads == 4, "Four search threads set up");
+    ASSERT(split.helpers[0].tt == split.tt && split.helpers[2].tt == split.tt, "Helpers share the table");
+    split.smp = mode;
+    
+    for (int i = 0; i < 3; i++) {
+        new_game(&serial);
+        new_game(&split);
+        serial.game_depth = split.game_depth = GAME_HARD;
+        human_move(&serial, openings[i] % BOARD_SIZE, openings[i] / BOARD_SIZE);
+        human_move(&split, openings[i] % BOARD_SIZE, openings[i] / BOARD_SIZE);
+        while (has_move(&serial.board) && evaluate(&serial.board) == SCORE_TIE) {
+            computer_move(&serial);
+            computer_move(&split);
+            if (serial.board.x != split.board.x) same = false;
+            if (!has_move(&serial.board) || evaluate(&serial.board) != SCORE_TIE) break;
+            int sq = bit_scan(empty_cells(&serial.board));
+            human_move(&serial, sq % BOARD_SIZE, sq / BOARD_SIZE);
+            human_move(&split, sq % BOARD_SIZE, sq / BOARD_SIZE);
+        }
+    }
+    ASSERT(same, "Threads choose the same moves as the serial search");
+    
+    engine_free(&serial);
+    engine_free(&split);
+    ASSERT(split.threads == 1 && split.helpers == NULL, "Helper contexts released");
+}
+
+void test_mcts() {
+    TEST("Monte Carlo Tree Search");
+    engine_ctx mc;
+    mcts_node * root;
+    int sq, visits = 0;
+    
+    ASSERT(engine_init(&mc, 1), "MCTS context ready");
+    engine_use(&mc, engine_find("MCTS"));
+    mc.book = false;
+    mc.playouts = 2000;
+    ASSERT(strcmp(engine_name(&mc), "MCTS") == 0, "Engine is named after the algorithm");
+    
+    /* one row away from a win */
+    new_game(&mc);
+    for (int c = 0; c < WIN_LENGTH - 1; c++) {
+        set_cell(&mc.board, c, 1, CELL_X);
+        if (c < WIN_LENGTH - 2) set_cell(&mc.board, c, 0, CELL_O);
+    }
+    set_cell(&mc.board, BOARD_SIZE - 1, BOARD_SIZE - 1, CELL_O);
+    mc.move_count = 2 * WIN_LENGTH - 2;
+    computer_move(&mc);
+    ASSERT(evaluate(&mc.board) == SCORE_X, "Playouts take the win");
+    
+#if BOARD_SIZE == 3
+    new_game(&mc);
+    set_cell(&mc.board, 0, 0, CELL_O);
+    set_cell(&mc.board, 1, 0, CELL_O);
+    set_cell(&mc.board, 1, 1, CELL_X);
+    mc.move_count = 3;
+    computer_move(&mc);
+    ASSERT(get_cell(&mc.board, 2, 0) == CELL_X, "Playouts block the human's win");
+#endif
+    
+    /* the tree of the reply survives the human's move */
+    new_game(&mc);
+    computer_move(&mc);
+    ASSERT(mc.states == mc.playouts, "Every playout is made");
+    ASSERT(mc.mcts->used <= mc.mcts->size, "Arena stays within its size");
+    root = &mc.mcts->nodes[mc.mcts->root];
+    sq = -1;
+    for (int i = 0; root->first != MCTS_LEAF && i < root->count; i++)
+        if (mc.mcts->nodes[root->first + i].visits > visits) {
+            visits = mc.mcts->nodes[root->first + i].visits;
+            sq = mc.mcts->nodes[root->first + i].move;
+        }
+    ASSERT(sq >= 0, "Human replies were looked at");
+    human_move(&mc, sq % BOARD_SIZE, sq / BOARD_SIZE);
+    ASSERT(mcts_follow(mc.mcts, &mc.board, mc.computer), "Tree follows the human's move");
+    ASSERT(mc.mcts->nodes[mc.mcts->root].visits == visits, "Playouts under the move are kept");
+    computer_move(&mc);
+    ASSERT(bit_count(mc.board.x) == 2 && bit_count(mc.board.o) == 1, "Reused tree makes one legal move");
+    
+    /* the clock instead of the playout count */
+    new_game(&mc);
+    mc.time_budget = 20;
+    int64_t start = clock_ms();
+    computer_move(&mc);
+    ASSERT(clock_ms() - start < 250 && mc.states > 0, "Timed playouts stop close to their budget");
+    
+    engine_free(&mc);
+    ASSERT(mc.mcts == NULL, "Tree released");
+}
+
+void test_parallel_mcts(int mode) {
+    TEST(mode == MCTS_SHARED ? "Tree Parallel MCTS" : "Root Parallel MCTS");
+    engine_ctx mc;
+    bool rooted = true;
+    
+    ASSERT(engine_init(&mc, 1) && engine_set_threads(&mc, 4), "Four Monte Carlo threads set up");
+    engine_use(&mc, engine_find("MCTS"));
+    mc.mcts_mode = mode;
+    mc.book = false;
+    mc.playouts = 4000;
+    
+    new_game(&mc);
+    for (int c = 0; c < WIN_LENGTH - 1; c++) {
+        set_cell(&mc.board, c, 1, CELL_X);
+        if (c < WIN_LENGTH - 2) set_cell(&mc.board, c, 0, CELL_O);
+    }
+    set_cell(&mc.board, BOARD_SIZE - 1, BOARD_SIZE - 1, CELL_O);
+    mc.move_count = 2 * WIN_LENGTH - 2;
+    computer_move(&mc);
+    ASSERT(evaluate(&mc.board) == SCORE_X, "Threads take the win");
+    
+#if BOARD_SIZE == 3
+    new_game(&mc);
+    set_cell(&mc.board, 0, 0, CELL_O);
+    set_cell(&mc.board, 1, 0, CELL_O);
+    set_cell(&mc.board, 1, 1, CELL_X);
+    mc.move_count = 3;
+    computer_move(&mc);
+    ASSERT(get_cell(&mc.board, 2, 0) == CELL_X, "Threads block the human's win");
+#endif
+    
+    new_game(&mc);
+    computer_move(&mc);
+    ASSERT(mc.states == mc.playouts, "Threads share out the playouts");
+    ASSERT(mc.mcts->used <= mc.mcts->size, "The tree stays within its arena");
+    if (mode == MCTS_SHARED) {
+        ASSERT(mc.mcts->nodes[mc.mcts->root].visits > 0, "Played move has the visits of the search");
+    } else {
+        /* the empty board was node 0 of every tree: merge its moves again */
+        int64_t merged[CELL_COUNT] = { 0 };
+        int played = bit_scan(mc.board.x), most = 0;
+        for (int i = 0; i < 4; i++) {
+            mcts_tree * t = i ? mc.helpers[i - 1].mcts : mc.mcts;
+            int32_t root = t->root;
+            t->root = 0;
+            mcts_tally(t, merged);
+            t->root = root;
+        }
+        for (int i = 0; i < CELL_COUNT; i++)
+            if (merged[i] > merged[most]) most = i;
+        ASSERT(merged[played] > 0 && merged[played] == merged[most],
+               "Played move has the most visits over all trees");
+    }
+    for (int i = 0; i < 3; i++)
+        if (mode == MCTS_ROOTS ? !mc.helpers[i].mcts || mc.helpers[i].mcts->x != mc.board.x
+                               : mc.helpers[i].mcts != NULL) rooted = false;
+    ASSERT(rooted, mode == MCTS_SHARED ? "Helpers walk the one tree" : "Every tree follows the move");
+    
+    engine_free(&mc);
+}
+
+void test_batch() {
+    TEST("Batch Analysis");
+    char cells[CELL_COUNT + 2], line[BATCH_LINE];
+    int win = BOARD_SIZE + WIN_LENGTH - 1, lines = 0, answers = 0;
+    batch_item item;
+    batch_job jobs[2];
+    FILE * in, * out;
+    
+    memset(cells, '.', CELL_COUNT);
+    cells[CELL_COUNT] = 0;
+    cells[0] = 'O';
+    ASSERT(batch_parse(&item, cells) && item.board.o == 1 && item.mover == CELL_X, "X is to move after the opening");
+    cells[1] = 'X';
+    ASSERT(batch_parse(&item, cells) && item.board.x == 2 && item.mover == CELL_O, "O is to move on even counts");
+    cells[2] = 'X';
+    ASSERT(!batch_parse(&item, cells), "Impossible piece counts are refused");
+    
+    /* X one short of a row, O one piece ahead */
+    memset(cells, '.', CELL_COUNT);
+    for (int c = 0; c < WIN_LENGTH - 1; c++) {
+        cells[BOARD_SIZE + c] = 'X';
+        if (c < WIN_LENGTH - 2) cells[c] = 'O';
+    }
+    cells[CELL_COUNT - 1] = cells[(BOARD_SIZE - 1) * BOARD_SIZE] = 'O';
+    
+    in = tmpfile();
+    out = tmpfile();
+    fprintf(in, "# comment\n%s\nnot a board\n\n", cells);
+    memset(cells, '.', CELL_COUNT);
+    fprintf(in, "%s\n", cells);
+    rewind(in);
+    for (int i = 0; i < 2; i++) {
+        engine_init(&jobs[i].ctx, BATCH_TT_MB);
+        jobs[i].ctx.game_depth = GAME_MEDIUM;
+    }
+    ASSERT(batch_run(in, out, jobs, 2), "Two workers go through the file");
+    rewind(out);
+    while (fgets(line, sizeof(line), out)) {
+        int n, move, score;
+        lines++;
+        if (lines == 1) answers += sscanf(line, "%d %d %d", &n, &move, &score) == 3
+                                && n == 2 && move == win && score > 0 && score_decided(score);
+        if (lines == 2) answers += !strcmp(line, "3 bad\n");
+        if (lines == 3) answers += sscanf(line, "%d %d", &n, &move) == 2 && n == 5 && move >= 0;
+    }
+    ASSERT(lines == 3 && answers == 3, "Answers come in input order, comments skipped");
+    for (int i = 0; i < 2; i++) engine_free(&jobs[i].ctx);
+    fclose(in);
+    fclose(out);
+    
+    /* an engine named with -e answers an empty board by its own search */
+    memset(cells, '.', CELL_COUNT);
+    batch_parse(&item, cells);
+    batch_setup(&jobs[0], GAME_IMPOSSIBLE, 0, engine_find("ABPRUNE"), NULL);
+    batch_analyze(&jobs[0].ctx, &item);
+    ASSERT(item.move >= 0 && item.nodes > 0 && !strcmp(engine_name(&jobs[0].ctx), "ABPRUNE"),
+           "A named engine searches instead of the book");
+    engine_free(&jobs[0].ctx);
+}
+
 void test_easy_mode() {
     TEST("Easy Mode Random Moves");
-    game_board test_board;
-    init_board(test_board);
+    new_game(&ctx);
     
-    human = CELL_O;
-    computer = CELL_X;
-    game_depth = GAME_EASY;
+    ctx.human = CELL_O;
+    ctx.computer = CELL_X;
+    ctx.game_depth = GAME_EASY;
     
-    srand((unsigned int)time(NULL));
+    ctx.rng = (uint64_t)time(NULL) | 1;
     
     for (int i = 0; i < 3; i++) {
-        init_board(test_board);
-        computer_move(test_board);
+        new_game(&ctx);
+        computer_move(&ctx);
         
         int moves = 0;
         for (int r = 0; r < BOARD_SIZE; r++)
             for (int c = 0; c < BOARD_SIZE; c++)
-                if (test_board[r][c] == CELL_X) moves++;
+                if (get_cell(&ctx.board, c, r) == CELL_X) moves++;
         
         ASSERT(moves == 1, "Easy mode makes valid move");
     }
+    
+    /* a context's own seed, not the C library's, decides the moves */
+    game_board first;
+    uint64_t seed = ctx.rng;
+    bool same = true;
+    for (int i = 0; i < 4; i++) {
+        new_game(&ctx);
+        ctx.rng = seed;
+        srand(i);                       /* no say in it */
+        computer_move(&ctx);
+        if (i == 0) first = ctx.board;
+        if (ctx.board.x != first.x) same = false;
+    }
+    ASSERT(same, "The same seed plays the same random move");
 }
 
 int main() {
     printf("===========================================\n");
     printf("  Tic-Tac-Toe AI Engine Validation Tests\n");
     printf("  Board Size: %dx%d\n", BOARD_SIZE, BOARD_SIZE);
-    printf("  Engine: %s\n", GAME_ENGINE);
+    engine_init(&ctx, 1);
+    printf("  Engine: %s\n", engine_name(&ctx));
     printf("===========================================\n");
     
     test_board_initialization();
     test_cell_operations();
+    test_bitboard_masks();
+    test_zobrist_keys();
+    test_symmetry();
+    test_transposition_table();
+    test_incremental_win_detection();
+    test_heuristic();
+    test_threat_search();
+    test_proof_number();
     test_win_detection_rows();
     test_win_detection_columns();
     test_win_detection_diagonals();
@@ -287,6 +1310,22 @@ int main() {
     test_computer_move();
     test_ai_blocking();
     test_ai_winning();
+    test_computer_as_o();
+    test_move_ordering();
+    test_pvs();
+    test_timed_search();
+    test_search_engines();
+    test_search_stats();
+    test_book();
+    test_solver();
+    test_solved_db();
+    test_independent_contexts();
+    test_parallel_search(SMP_SPLIT);
+    test_parallel_search(SMP_LAZY);
+    test_mcts();
+    test_parallel_mcts(MCTS_SHARED);
+    test_parallel_mcts(MCTS_ROOTS);
+    test_batch();
     test_easy_mode();
     
     printf("\n===========================================\n");
@@ -296,5 +1335,6 @@ int main() {
     printf("  Total:    %d\n", tests_passed + tests_failed);
     printf("===========================================\n");
     
+    engine_free(&ctx);
     return tests_failed > 0 ? 1 : 0;
 }
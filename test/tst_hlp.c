@@ -44,22 +44,25 @@ void test_mssleep_function() {
     ASSERT(1, "mssleep(1) executes without error");
 }
 
-void test_progress_interval() {
-    TEST("Progress Interval Configuration");
+void test_progress_renderer() {
+    TEST("Progress Renderer");
     
-    int original_update = progress_update;
+    search_info info = {0, GAME_HARD, -1};
+    int frames = progress_pacifier;
     
-    progress_interval(5);
-    ASSERT(progress_update == 5 * BOARD_SIZE, "progress_interval(5) sets correct update frequency");
+    progress_start(&info);
+    ASSERT(progress_running, "Renderer is running after start");
+    for (long n = 1; n <= 1000; n++)
+        atomic_put(&info.nodes, n);     /* a search publishing its counters */
+    mssleep(3 * 1000 / PROGRESS_FPS);
+    progress_stop();
     
-    progress_interval(10);
-    ASSERT(progress_update == 10 * BOARD_SIZE, "progress_interval(10) updates value correctly");
+    ASSERT(!progress_running, "Renderer stopped");
+    ASSERT(progress_info == NULL, "The watched search is forgotten once stopped");
+    ASSERT(progress_pacifier > frames, "Frames drawn at a fixed rate");
     
-    progress_interval(1);
-    ASSERT(progress_update == 1 * BOARD_SIZE, "progress_interval(1) sets minimum frequency");
-    
-    // Restore original
-    progress_update = original_update;
+    progress_stop();
+    ASSERT(1, "Stopping twice is harmless");
 }
 
 void test_progress_show() {
@@ -69,7 +72,6 @@ void test_progress_show() {
     progress_pacifier = 0;
     progress_current = 0;
     progress_dir = +1;
-    progress_update = 1;
     
     int original_pacifier = progress_pacifier;
     
@@ -90,7 +92,6 @@ void test_progress_direction() {
     progress_pacifier = 0;
     progress_current = 0;
     progress_dir = +1;
-    progress_update = 1;
     
     // Run through enough iterations to test direction change
     for (int i = 0; i < PROGRESS_TOTAL * 3; i++) {
@@ -156,7 +157,6 @@ void test_global_variables() {
     ASSERT(progress_current >= 0, "progress_current initialized to valid value");
     ASSERT(progress_dir == 1 || progress_dir == -1, "progress_dir has valid direction");
     ASSERT(progress_pacifier >= 0, "progress_pacifier initialized to valid value");
-    ASSERT(progress_update > 0, "progress_update is positive");
 }
 
 int main() {
@@ -167,7 +167,7 @@ int main() {
     
     test_clear_function();
     test_mssleep_function();
-    test_progress_interval();
+    test_progress_renderer();
     test_progress_show();
     test_progress_direction();
     test_progress_array();
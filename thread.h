@@ -0,0 +1,123 @@
+/*
+ * THREAD.H: Tic-Tac-Toe AI threads, atomics and clock
+ * ---------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ */
+#ifndef _TICTACTOE_MINIMAX_THREAD_H_
+#define _TICTACTOE_MINIMAX_THREAD_H_
+
+#include <time.h>
+#include "defs.h"
+
+/* Threads: available everywhere but on DOS, where every
+ * "thread" simply runs to completion when it is started
+ */
+#ifndef __DJGPP__
+    #define _USE_THREADS_
+#endif
+
+#ifdef _USE_THREADS_
+    #include <pthread.h>
+    #ifdef _WIN32
+        #include <windows.h>
+    #else
+        #include <unistd.h>
+    #endif
+    typedef pthread_t thread_t;
+#else
+    typedef int thread_t;
+#endif
+
+typedef void * (*thread_func)(void * arg);
+
+/* atomics on plain integer fields (GCC/Clang builtins), relaxed unless
+ * publishing memory written before them
+ */
+#define atomic_get(p)           __atomic_load_n((p), __ATOMIC_RELAXED)
+#define atomic_put(p, v)        __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define atomic_add(p, v)        __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define atomic_or(p, v)         __atomic_fetch_or((p), (v), __ATOMIC_RELAXED)
+#define atomic_acquire(p)       __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define atomic_release(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define atomic_cas(p, e, v)     __atomic_compare_exchange_n((p), (e), (v), true,   \
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+
+/* =============== PROTOTYPES ==================== */
+
+bool thread_start(thread_t * t, thread_func func, void * arg);
+
+void thread_join(thread_t t);
+
+int cpu_count();
+
+int64_t clock_ms();
+
+int64_t clock_us();
+
+/* =============================================== */
+
+bool thread_start(thread_t * t, thread_func func, void * arg) {
+#ifdef _USE_THREADS_
+    return pthread_create(t, NULL, func, arg) == 0;
+#else
+    *t = 0;
+    func(arg);
+    return true;
+#endif
+}
+
+void thread_join(thread_t t) {
+#ifdef _USE_THREADS_
+    pthread_join(t, NULL);
+#else
+    (void)t;
+#endif
+}
+
+/* number of online processors, at least 1 */
+int cpu_count() {
+    int n = 1;
+#ifdef _USE_THREADS_
+    #ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    n = (int)info.dwNumberOfProcessors;
+    #else
+    n = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    #endif
+#endif
+    return n < 1 ? 1 : n;
+}
+
+/* monotonic milliseconds, only differences between readings matter */
+int64_t clock_ms() {
+#if defined(_WIN32)
+    return (int64_t)GetTickCount64();
+#elif defined(__DJGPP__)
+    return (int64_t)clock() * 1000 / CLOCKS_PER_SEC;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
+
+/* monotonic microseconds, for timing short searches */
+int64_t clock_us() {
+#if defined(_WIN32)
+    LARGE_INTEGER now, freq;
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&freq);
+    return (int64_t)(now.QuadPart / freq.QuadPart * 1000000
+                   + now.QuadPart % freq.QuadPart * 1000000 / freq.QuadPart);
+#elif defined(__DJGPP__)
+    return (int64_t)uclock() * 1000000 / UCLOCKS_PER_SEC;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * THREAT.H: Tic-Tac-Toe AI threat space search
+ * ---------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ */
+#ifndef _TICTACTOE_MINIMAX_THREAT_H_
+#define _TICTACTOE_MINIMAX_THREAT_H_
+
+#include "defs.h"
+#include "board.h"
+
+/* Victory by continuous fours: the attacker only plays moves that leave a
+ * window one piece short of a win, so every reply of the defender is
+ * forced, until two such windows are open at once. Only forcing moves are
+ * looked at, which keeps the search narrow on boards far too big for a
+ * full width search.
+ */
+#define VCF_DEPTH       (CELL_COUNT / 2)    /* most attacking moves in a row */
+
+/* =============== PROTOTYPES ==================== */
+
+bitmask win_cells(game_board * g, int side);
+
+bitmask four_cells(game_board * g, int side);
+
+bool vcf(game_board * g, char piece, int depth, int * move);
+
+int vcf_move(game_board * g, char piece);
+
+/* =============================================== */
+
+/* empty cells where 'side' (0 = X, 1 = O) completes a window */
+bitmask win_cells(game_board * g, int side) {
+    bitmask cells = 0;
+    for (int i = 0; i < LINE_COUNT; i++)
+        if (g->count[side][i] == WIN_LENGTH - 1 && !g->count[!side][i])
+            cells |= line_masks[i];
+    return cells & empty_cells(g);
+}
+
+/* empty cells where 'side' leaves a window one piece short of a win */
+bitmask four_cells(game_board * g, int side) {
+    bitmask cells = 0;
+    for (int i = 0; i < LINE_COUNT; i++)
+        if (g->count[side][i] == WIN_LENGTH - 2 && !g->count[!side][i])
+            cells |= line_masks[i];
+    return cells & empty_cells(g);
+}
+
+/* can 'piece', to move, win by fours alone within 'depth' of its moves?
+ * 'move' gets the first move of the win
+ */
+bool vcf(game_board * g, char piece, int depth, int * move) {
+    int me = piece != CELL_X, sq, reply, next;
+    char other = piece == CELL_X ? CELL_O : CELL_X;
+    bitmask wins = win_cells(g, me), danger, tries, replies;
+    bool won;
+
+    if (wins) {                         /* a window is one piece short */
+        *move = bit_scan(wins);
+        return true;
+    }
+    if (depth <= 0) return false;
+
+    danger = win_cells(g, !me);         /* the defender's own fours */
+    if (danger & (danger - 1)) return false;    /* two to stop, no time to attack */
+    tries = four_cells(g, me);
+    if (danger) tries &= danger;        /* the four must block as well */
+
+    for (; tries; tries &= tries - 1) {
+        sq = bit_scan(tries);
+        place(g, sq, piece);
+        replies = win_cells(g, me);
+        won = false;
+        if (!win_cells(g, !me)) {       /* the defender cannot win first */
+            if (replies & (replies - 1)) won = true;    /* two fours at once */
+            else if (replies) {
+                reply = bit_scan(replies);
+                place(g, reply, other);     /* the forced block */
+                won = vcf(g, piece, depth - 1, &next);
+                unplace(g, reply, other);
+            }
+        }
+        unplace(g, sq, piece);
+        if (won) {
+            *move = sq;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* first move of a win by continuous fours for 'piece', -1 if none */
+int vcf_move(game_board * g, char piece) {
+    int sq;
+    return vcf(g, piece, VCF_DEPTH, &sq) ? sq : -1;
+}
+
+#endif
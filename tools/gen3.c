@@ -0,0 +1,98 @@
+/*
+ * GEN3.C: Tic-Tac-Toe AI perfect play table generator
+ * -------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ *
+ * Solves the 3x3 game and writes book3.h to the standard output:
+ *   gen3 > book3.h
+ */
+#define BOARD_SIZE 3
+#define _BOOK_GENERATOR_
+#include <stdio.h>
+#include <string.h>
+#include "../defs.h"
+#include "../board.h"
+#include "../book.h"
+
+#define CODES       19683               /* 3^9 boards */
+#define UNKNOWN     127
+
+signed char memo[CODES][2];             /* solved values, UNKNOWN if not yet */
+
+/* value for 'side' to move: wins count 10 less one per ply it takes,
+ * losses the other way round, a full board is 0. Equal moves go by the
+ * static move order.
+ */
+int solve(game_board * g, int side, int * move) {
+    char piece = side ? CELL_O : CELL_X;
+    int i, sq, v, best = -100;
+    uint64_t code = board_code(g, 0);
+
+    if (!move && memo[code][side] != UNKNOWN) return memo[code][side];
+    for (i = 0; i < CELL_COUNT; i++) {
+        sq = move_order[i];
+        if (!(empty_cells(g) & ((bitmask)1 << sq))) continue;
+        place(g, sq, piece);
+        if (wins_at(g, sq, piece)) v = 10;
+        else if (!empty_cells(g)) v = 0;
+        else {
+            v = -solve(g, !side, NULL);
+            v += v > 0 ? -1 : v < 0 ? 1 : 0;    /* one ply further away */
+        }
+        unplace(g, sq, piece);
+        if (v > best) {
+            best = v;
+            if (move) *move = sq;
+        }
+    }
+    return memo[code][side] = best;
+}
+
+/* can 'side' be the one to move, whoever started? */
+bool legal(game_board * g, int side) {
+    int x = bit_count(g->x), o = bit_count(g->o);
+    for (int i = 0; i < LINE_COUNT; i++)
+        if (g->count[0][i] == WIN_LENGTH || g->count[1][i] == WIN_LENGTH) return false;
+    if (!empty_cells(g)) return false;
+    return side ? (o == x || o == x - 1) : (x == o || x == o - 1);
+}
+
+int main() {
+    game_board g;
+    int code, side, sym, move, v, n = 0, rest;
+    uint32_t entries[2 * CODES];
+
+    init_masks();
+    memset(memo, UNKNOWN, sizeof(memo));
+    for (code = 0; code < CODES; code++) {
+        memset(&g, 0, sizeof(game_board));
+        for (int sq = 0, c = code; sq < CELL_COUNT; sq++, c /= 3)
+            if (c % 3) place(&g, sq, c % 3 == 1 ? CELL_X : CELL_O);
+        for (side = 0; side < 2; side++) {
+            if (!legal(&g, side)) continue;
+            if (book_key(&g, side ? CELL_O : CELL_X, &sym) != (uint64_t)code * 2 + side)
+                continue;               /* a symmetric twin is the canonical one */
+            v = solve(&g, side, &move);
+            entries[n++] = BOOK_ENTRY(code, side, v > 0 ? BOOK_WIN : v < 0 ? BOOK_LOSS : BOOK_DRAW, move);
+        }
+    }
+
+    printf("/*\n"
+           " * BOOK3.H: Tic-Tac-Toe AI perfect play table for 3x3\n"
+           " * --------\n"
+           " * Generated by tools/gen3.c, do not edit: run \"make book\" instead\n"
+           " */\n"
+           "#ifndef _TICTACTOE_MINIMAX_BOOK3_H_\n"
+           "#define _TICTACTOE_MINIMAX_BOOK3_H_\n\n"
+           "#define BOOK3_SIZE %d\n\n"
+           "const uint32_t book3[BOOK3_SIZE] = {\n", n);
+    for (int i = 0; i < n; i += 8) {
+        printf("   ");
+        rest = n - i < 8 ? n - i : 8;
+        for (int j = 0; j < rest; j++) printf(" 0x%07X,", entries[i + j]);
+        printf("\n");
+    }
+    printf("};\n\n#endif\n");
+    return 0;
+}
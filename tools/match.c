@@ -0,0 +1,254 @@
+/*
+ * MATCH.C: Tic-Tac-Toe AI self-play tournament
+ * --------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ *
+ * Plays two engine settings against each other on every core and reports
+ * the result of the first one with a 95% confidence interval, and the
+ * time and nodes each side spent a move. Games come in pairs: the same
+ * random opening is played twice, each side opening once. The openings
+ * and the random player's moves follow from the seed alone.
+ *   match [-g games] [-o plies] [-j threads] [-m MB] [-s seed] A B
+ * where a player is a registered engine, any case, with an optional
+ * depth, or playouts for MCTS, or time a move: minimax/4, abprune,
+ * pvs/200ms, pn2, mcts/2000; 'random' plays random moves
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../defs.h"
+#include "../engine.h"
+
+#define MATCH_GAMES     200             /* games of a match */
+#define MATCH_OPENING   2               /* random plies before the engines play */
+#define MATCH_TT_MB     4               /* table of each engine */
+
+typedef struct {                        /* an engine and its settings */
+    const char * spec;                  /* as given on the command line */
+    const search_engine * engine;       /* picks its moves */
+    int depth;                          /* ply limit, GAME_EASY = random moves */
+    int ms;                             /* time a move, 0 = fixed depth */
+    int playouts;                       /* Monte Carlo playouts a move */
+} match_player;
+
+typedef struct {                        /* what one player did in the games */
+    long moves;
+    int64_t us;                         /* time spent on its moves */
+    int64_t nodes;                      /* states searched on its moves */
+} match_tally;
+
+typedef struct {                        /* a worker: both engines and its results */
+    engine_ctx ctx[2];
+    match_tally tally[2];
+    long wins, draws, losses;           /* of the first player */
+} match_worker;
+
+static match_player players[2];
+static int games = MATCH_GAMES, opening = MATCH_OPENING, next_game = 0;
+static uint64_t seed = 1;
+
+/* "pvs/6", "mcts/2000", "abprune/150ms" into a player, false if unknown */
+static bool match_parse(match_player * p, const char * spec) {
+    const char * slash = strchr(spec, '/');
+    size_t length = slash ? (size_t)(slash - spec) : strlen(spec);
+    int n = slash ? atoi(slash + 1) : 0;
+    bool random = length == 6 && !strncmp(spec, "random", 6);
+    char name[32];
+
+    memset(p, 0, sizeof(match_player));
+    p->spec = spec;
+    if (length >= sizeof(name) || (slash && n <= 0)) return false;
+    memcpy(name, spec, length);
+    name[length] = 0;
+    p->engine = engine_find(random ? "PVS" : name);
+    if (!p->engine) return false;
+
+    p->depth = random ? GAME_EASY : GAME_IMPOSSIBLE;
+    p->playouts = MCTS_PLAYOUTS;
+    if (slash && strstr(slash, "ms")) {
+        p->ms = n;
+        p->depth = CELL_COUNT;          /* only the clock limits the search */
+    }
+    else if (slash && !strcmp(p->engine->name, "MCTS")) p->playouts = n;
+    else if (slash && !random) p->depth = n > GAME_EASY ? n : GAME_EASY + 1;
+    return true;
+}
+
+static void match_setup(engine_ctx * ctx, match_player * p) {
+    engine_use(ctx, p->engine);
+    ctx->game_depth = p->depth;
+    ctx->time_budget = p->ms;
+    ctx->playouts = p->playouts;
+    ctx->book = false;                  /* the engines themselves are compared */
+}
+
+/* random state of a pair of games, the same for every run with the seed */
+static uint64_t match_seed(int pair) {
+    return (seed * 0x9E3779B97F4A7C15ULL + (uint64_t)pair * 0xBF58476D1CE4E5B9ULL) | 1;
+}
+
+/* the random opening of a pair of games, never a winning move; it ends
+ * early if every move left would win
+ */
+static int match_opening(int pair, int * moves) {
+    uint64_t state = match_seed(pair);
+    game_board g;
+    int list[CELL_COUNT], n, safe, count = 0, sq;
+    char side = CELL_O;                 /* O opens, as in the game */
+
+    init_board(&g);
+    for (int ply = 0; ply < opening && ply < CELL_COUNT - 1; ply++) {
+        n = gen_moves(&g, list);
+        for (int i = safe = 0; i < n; i++) {    /* keep the moves that do not win */
+            place(&g, list[i], side);
+            if (!wins_at(&g, list[i], side)) list[safe++] = list[i];
+            unplace(&g, list[i], side);
+        }
+        if (safe == 0) break;
+        sq = list[mcts_random(&state) % safe];
+        place(&g, sq, side);
+        moves[count++] = sq;
+        side = side == CELL_X ? CELL_O : CELL_X;
+    }
+    return count;
+}
+
+/* one game, 'first' being the player that opens; the result for player 0 */
+static int match_game(match_worker * w, int pair, int first) {
+    game_board g;
+    int moves[CELL_COUNT], n = match_opening(pair, moves), sq, score, p;
+    char side = CELL_O;
+    int64_t start;
+
+    init_board(&g);
+    for (int i = 0; i < n; i++) {
+        place(&g, moves[i], side);
+        side = side == CELL_X ? CELL_O : CELL_X;
+    }
+    for (p = 0; p < 2; p++) {
+        new_game(&w->ctx[p]);
+        w->ctx[p].rng = match_seed(pair) * (2 * p + 3) | 1;   /* random moves of the pair */
+    }
+    while (has_move(&g)) {
+        p = (side == CELL_O) == (first == 0) ? 0 : 1;
+        engine_ctx * ctx = &w->ctx[p];
+        ctx->board = g;
+        ctx->computer = ctx->current = side;
+        ctx->human = side == CELL_X ? CELL_O : CELL_X;
+        ctx->move_count = bit_count(g.x | g.o);
+        start = clock_us();
+        sq = select_move(ctx, &score);
+        w->tally[p].us += clock_us() - start;
+        w->tally[p].nodes += ctx->states;
+        w->tally[p].moves++;
+        place(&g, sq, side);
+        if (wins_at(&g, sq, side)) return p == 0 ? 1 : -1;
+        side = side == CELL_X ? CELL_O : CELL_X;
+    }
+    return 0;
+}
+
+static void * match_worker_run(void * arg) {
+    match_worker * w = (match_worker *)arg;
+    int i, result;
+
+    while ((i = atomic_add(&next_game, 1)) < games) {
+        result = match_game(w, i / 2, i % 2);
+        if (result > 0) w->wins++;
+        else if (result < 0) w->losses++;
+        else w->draws++;
+    }
+    return NULL;
+}
+
+/* Elo difference of a score fraction, clamped short of infinity */
+static double elo(double score) {
+    if (score < 0.001) score = 0.001;
+    if (score > 0.999) score = 0.999;
+    return -400.0 * log10(1.0 / score - 1.0);
+}
+
+int main(int argc, char ** argv) {
+    int threads = cpu_count(), mb = MATCH_TT_MB, named = 0, started, i, p;
+    const char * specs[2] = { NULL, NULL };
+    match_worker * workers;
+    thread_t tid[MAX_THREADS];
+    match_tally tally[2];
+    long wins = 0, draws = 0, losses = 0, n;
+    double score, var, margin;
+
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-g") && i + 1 < argc)      games = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc) opening = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-j") && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-m") && i + 1 < argc) mb = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc) seed = strtoull(argv[++i], NULL, 10);
+        else if (named < 2) specs[named++] = argv[i];
+        else named = 3;
+    }
+    if (named != 2 || games < 1 || opening < 0 || threads < 1 || mb < 1
+     || !match_parse(&players[0], specs[0]) || !match_parse(&players[1], specs[1])) {
+        fprintf(stderr, "match [-g games] [-o plies] [-j threads] [-m MB] [-s seed] A B\n"
+                        "  players: random, or an engine[/depth], mcts[/playouts], engine/ms:\n");
+        for (i = 0; i < engine_count(); i++)
+            fprintf(stderr, "    %-8s %s\n", engine_at(i)->name, engine_at(i)->info);
+        return 2;
+    }
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (threads > games) threads = games;
+
+    workers = (match_worker *)calloc(threads, sizeof(match_worker));
+    for (n = 0; workers && n < 2 * threads; n++) {    /* both contexts of each worker */
+        if (!engine_init(&workers[n / 2].ctx[n % 2], mb)) break;
+        match_setup(&workers[n / 2].ctx[n % 2], &players[n % 2]);
+    }
+    if (!workers || n < 2 * threads) {
+        fprintf(stderr, "out of memory\n");
+        for (i = 0; workers && i < n; i++) engine_free(&workers[i / 2].ctx[i % 2]);
+        free(workers);
+        return 1;
+    }
+
+    printf("%dx%d board, %d in a row: %s (%s) against %s (%s)\n", BOARD_SIZE, BOARD_SIZE,
+           WIN_LENGTH, players[0].spec, engine_name(&workers[0].ctx[0]),
+           players[1].spec, engine_name(&workers[0].ctx[1]));
+    printf("%d games, %d random opening plies, %d threads\n", games, opening, threads);
+    for (started = 1; started < threads; started++)
+        if (!thread_start(&tid[started], match_worker_run, &workers[started])) break;
+    match_worker_run(&workers[0]);      /* this thread is worker 0 */
+
+    memset(tally, 0, sizeof(tally));
+    for (i = 0; i < threads; i++) {
+        if (i > 0 && i < started) thread_join(tid[i]);
+        wins += workers[i].wins;
+        draws += workers[i].draws;
+        losses += workers[i].losses;
+        for (p = 0; p < 2; p++) {
+            tally[p].moves += workers[i].tally[p].moves;
+            tally[p].us += workers[i].tally[p].us;
+            tally[p].nodes += workers[i].tally[p].nodes;
+        }
+    }
+
+    /* score of the first player and the normal 95% interval of its mean */
+    n = wins + draws + losses;
+    score = (wins + 0.5 * draws) / n;
+    var = (wins * (1 - score) * (1 - score) + draws * (0.5 - score) * (0.5 - score)
+         + losses * score * score) / n;
+    margin = 1.96 * sqrt(var / n);
+    printf("%s: %ld wins, %ld draws, %ld losses\n", players[0].spec, wins, draws, losses);
+    printf("score %.1f%% +- %.1f%%, Elo %+.0f [%+.0f, %+.0f]\n", 100 * score, 100 * margin,
+           elo(score), elo(score - margin), elo(score + margin));
+    printf("%-16s %10s %12s %14s\n", "player", "moves", "us/move", "nodes/move");
+    for (p = 0; p < 2; p++)
+        printf("%-16s %10ld %12.1f %14.1f\n", players[p].spec, tally[p].moves,
+               tally[p].moves ? (double)tally[p].us / tally[p].moves : 0.0,
+               tally[p].moves ? (double)tally[p].nodes / tally[p].moves : 0.0);
+
+    for (i = 0; i < threads; i++)
+        for (p = 0; p < 2; p++) engine_free(&workers[i].ctx[p]);
+    free(workers);
+    return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ * MCBENCH.C: Tic-Tac-Toe AI Monte Carlo playout throughput
+ * ----------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ *
+ * Runs the Monte Carlo search from the empty board for a fixed time with
+ * 1, 2, 4, ... threads up to the given count, in both ways of sharing the
+ * work, and prints the playouts made per second:
+ *   mcbench [threads] [ms]     (default: all cores, 1000 ms)
+ */
+#ifndef BOARD_SIZE
+#define BOARD_SIZE 8
+#define WIN_LENGTH 5
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include "../defs.h"
+#include "../engine.h"
+
+int main(int argc, char ** argv) {
+    int most = argc > 1 ? atoi(argv[1]) : cpu_count();
+    int ms = argc > 2 ? atoi(argv[2]) : 1000;
+    const char * names[2] = { "shared tree", "tree per thread" };
+    int64_t start, rate, base[2] = { 0, 0 };
+    int mode, threads;
+
+    if (!engine_init(&engine, 1)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    engine_use(&engine, engine_find("MCTS"));
+    engine.book = false;
+    engine.game_depth = CELL_COUNT;
+    engine.time_budget = ms > 0 ? ms : 1000;
+    if (most < 1) most = 1;
+    if (most > MAX_THREADS) most = MAX_THREADS;
+
+    printf("%dx%d board, %d in a row, %d ms a run\n", BOARD_SIZE, BOARD_SIZE,
+           WIN_LENGTH, engine.time_budget);
+    for (threads = 1; ; threads = threads * 2 < most ? threads * 2 : most) {
+        if (!engine_set_threads(&engine, threads)) {
+            fprintf(stderr, "out of memory\n");
+            break;
+        }
+        for (mode = MCTS_SHARED; mode <= MCTS_ROOTS; mode++) {
+            engine.mcts_mode = mode;
+            new_game(&engine);
+            start = clock_ms();
+            computer_move(&engine);
+            rate = engine.states * 1000 / (clock_ms() - start > 0 ? clock_ms() - start : 1);
+            if (threads == 1) base[mode] = rate;
+            printf("%2d threads, %-15s: %10lld playouts/s, %5.2fx\n", threads, names[mode],
+                   (long long)rate, base[mode] ? (double)rate / base[mode] : 0.0);
+        }
+        if (threads == most) break;
+    }
+    engine_free(&engine);
+    return 0;
+}
@@ -0,0 +1,44 @@
+/*
+ * SOLVE.C: Tic-Tac-Toe AI solved position database builder
+ * --------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ *
+ * Solves every position of the board with the solver of solver.h and
+ * writes the database read by db.h:
+ *   solve [threads] [file]     (default: all cores, c3_NxN.db)
+ */
+#ifndef BOARD_SIZE
+#define BOARD_SIZE 4
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include "../defs.h"
+#include "../solver.h"
+
+#if CELL_COUNT > SOLVER_MAX_CELLS
+    #error "the solver is for boards up to 4x4"
+#endif
+
+int main(int argc, char ** argv) {
+    solver_ctx solver;
+    char path[64];
+
+    if (!solver_init(&solver, argc > 1 ? atoi(argv[1]) : cpu_count())) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    solver_run(&solver);
+    solver_report(&solver, stderr);
+
+    db_path(path);
+    if (!solver_write(&solver, argc > 2 ? argv[2] : path)) {
+        fprintf(stderr, "cannot write %s\n", argc > 2 ? argv[2] : path);
+        solver_free(&solver);
+        return 1;
+    }
+    fprintf(stderr, "%s written, empty board: %s\n", argc > 2 ? argv[2] : path,
+            (char *[]){ "none", "loss", "draw", "win" }[db_get(solver.values, 0)]);
+    solver_free(&solver);
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ * TTABLE.H: Tic-Tac-Toe AI transposition table
+ * ---------
+ * Coded by Trinh D.D. Nguyen
+ * Last updates: Oct, 2026
+ */
+#ifndef _TICTACTOE_MINIMAX_TTABLE_H_
+#define _TICTACTOE_MINIMAX_TTABLE_H_
+
+#include <stdlib.h>
+#include <string.h>
+#include "defs.h"
+#include "thread.h"
+
+/* entry data layout: score:32 | move:8 | depth:8 | bound:2 | age:6 */
+#define TT_PACK(score, move, depth, bound, age)                  \
+            ((uint64_t)(uint32_t)(score)                         \
+           | ((uint64_t)(uint8_t)(move)  << 32)                  \
+           | ((uint64_t)(uint8_t)(depth) << 40)                  \
+           | ((uint64_t)(bound)          << 48)                  \
+           | ((uint64_t)(age)            << 50))
+#define TT_SCORE(d)     ((int)(int32_t)(uint32_t)(d))
+#define TT_MOVE(d)      ((int)(((d) >> 32) & 0xFF))
+#define TT_DEPTH(d)     ((int)(int8_t)(((d) >> 40) & 0xFF))
+#define TT_BOUND(d)     ((int)(((d) >> 48) & 3))
+#define TT_AGE(d)       ((int)(((d) >> 50) & TT_AGE_MASK))
+#define TT_AGE_MASK     63
+
+/* Entries are shared by all search threads without a lock: the key is
+ * stored XORed with the data, so an entry torn by two racing writers
+ * simply fails to verify and reads as a miss.
+ */
+#define TT_READ(e, k, d)    ((d) = atomic_get(&(e)->data),              \
+                             (k) = atomic_get(&(e)->key) ^ (d))
+#define TT_WRITE(e, k, d)   (atomic_put(&(e)->data, (d)),               \
+                             atomic_put(&(e)->key, (k) ^ (d)))
+
+/* =============== PROTOTYPES ==================== */
+
+bool tt_init(trans_table * tt, size_t mb);
+
+void tt_free(trans_table * tt);
+
+void clear_trans_table(trans_table * tt);
+
+void tt_new_search(trans_table * tt);
+
+int score_bound(int score, int alpha, int beta);
+
+int score_to_tt(int score, int ply);
+
+int score_from_tt(int score, int ply);
+
+bool lookup_trans_table(trans_table * tt, uint64_t key, int depth, int ply,
+                        int alpha, int beta, int * score, int * move);
+
+int store_trans_table(trans_table * tt, uint64_t key, int score, int depth,
+                      int ply, int bound, int move);
+
+/* =============================================== */
+
+/* allocate a table of about 'mb' megabytes, rounded down to a power of two */
+bool tt_init(trans_table * tt, size_t mb) {
+    size_t buckets = 1;
+
+    if (mb == 0) mb = 1;
+    while (buckets * 2 * sizeof(trans_bucket) <= (mb << 20)) buckets *= 2;
+
+    tt_free(tt);
+    for (; buckets > 0; buckets /= 2) {     /* shrink until it fits */
+        tt->memory = malloc(buckets * sizeof(trans_bucket) + 63);
+        if (tt->memory) break;
+    }
+    if (!tt->memory) return false;
+
+    /* buckets start on a cache line boundary */
+    tt->buckets = (trans_bucket *)(((uintptr_t)tt->memory + 63) & ~(uintptr_t)63);
+    tt->mask = buckets - 1;
+    clear_trans_table(tt);
+    return true;
+}
+
+void tt_free(trans_table * tt) {
+    free(tt->memory);
+    tt->memory = NULL;
+    tt->buckets = NULL;
+    tt->mask = 0;
+}
+
+void clear_trans_table(trans_table * tt) {
+    memset(tt->buckets, 0, (tt->mask + 1) * sizeof(trans_bucket));
+    tt->age = 0;
+}
+
+/* entries from older searches become cheaper to replace */
+void tt_new_search(trans_table * tt) {
+    tt->age = (tt->age + 1) & TT_AGE_MASK;
+}
+
+/* classify a search result against the window it was searched with */
+int score_bound(int score, int alpha, int beta) {
+    if (score <= alpha) return BOUND_UPPER;
+    if (score >= beta)  return BOUND_LOWER;
+    return BOUND_EXACT;
+}
+
+/* a win 'ply' moves into the search is kept as counted from its own
+ * position, so it reads right from wherever that position is reached
+ */
+int score_to_tt(int score, int ply) {
+    if (score >= SCORE_MATE)  return score + ply;
+    if (score <= -SCORE_MATE) return score - ply;
+    return score;
+}
+
+int score_from_tt(int score, int ply) {
+    if (score >= SCORE_MATE)  return score - ply;
+    if (score <= -SCORE_MATE) return score + ply;
+    return score;
+}
+
+/* probe the table at 'ply' moves from the root: returns true on a cutoff,
+ * 'move' gets the best move hint
+ */
+bool lookup_trans_table(trans_table * tt, uint64_t key, int depth, int ply,
+                        int alpha, int beta, int * score, int * move) {
+    trans_bucket * b = &tt->buckets[key & tt->mask];
+    uint64_t k, d;
+    int s, bound;
+
+    *move = -1;
+    for (int i = 0; i < TT_BUCKET_SIZE; i++) {
+        TT_READ(&b->entry[i], k, d);
+        if (k != key || TT_BOUND(d) == BOUND_NONE) continue;
+
+        if (TT_MOVE(d) != TT_NO_MOVE) *move = TT_MOVE(d);
+        if (TT_DEPTH(d) < depth) return false;  /* too shallow to trust */
+
+        s = score_from_tt(TT_SCORE(d), ply);
+        bound = TT_BOUND(d);
+        if (bound == BOUND_EXACT
+        || (bound == BOUND_LOWER && s >= beta)
+        || (bound == BOUND_UPPER && s <= alpha)) {
+            *score = s;
+            return true;
+        }
+        return false;
+    }
+    return false;
+}
+
+/* store a result, replacing the shallowest and oldest entry of the bucket;
+ * returns the tt_store that happened
+ */
+int store_trans_table(trans_table * tt, uint64_t key, int score, int depth,
+                      int ply, int bound, int move) {
+    trans_bucket * b = &tt->buckets[key & tt->mask];
+    trans_entry * victim = &b->entry[0];
+    int value, worst = 0x7FFFFFFF, result = TT_REPLACED;
+    uint64_t k, d;
+
+    for (int i = 0; i < TT_BUCKET_SIZE; i++) {
+        trans_entry * e = &b->entry[i];
+        TT_READ(e, k, d);
+        if (TT_BOUND(d) == BOUND_NONE) {    /* free slot */
+            victim = e;
+            result = TT_STORED;
+            break;
+        }
+        if (k == key) {                     /* same position */
+            /* keep a deeper result of this search unless the new one is exact */
+            if (TT_AGE(d) == tt->age && TT_DEPTH(d) > depth && bound != BOUND_EXACT)
+                return TT_KEPT;
+            if (move < 0) move = TT_MOVE(d);
+            victim = e;
+            result = TT_STORED;
+            break;
+        }
+        value = TT_DEPTH(d) - 4 * ((tt->age - TT_AGE(d)) & TT_AGE_MASK);
+        if (value < worst) {
+            worst = value;
+            victim = e;
+        }
+    }
+    if (move < 0) move = TT_NO_MOVE;
+    d = TT_PACK(score_to_tt(score, ply), move, depth, bound, tt->age);
+    TT_WRITE(victim, key, d);
+    return result;
+}
+
+#endif